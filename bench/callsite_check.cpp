@@ -0,0 +1,169 @@
+/*
+    Pico Log - Call-site registry check.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+/*
+    Checks the logging macros built with PICO_LOG_CALLSITES, from the kinds of functions GCC
+    places in different sections: a method defined in a class body, a template,
+    an inline function and a free function, all in the same file.
+    Every call site must be registered, and be enabled, disabled and forced at run-time.
+    Exits with a non-zero status if any check fails.
+*/
+
+#include "pico_log_lib/logger.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifndef PICO_LOG_CALLSITES
+#error "The call-site check requires PICO_LOG_CALLSITES."
+#endif
+
+
+static size_t failures = 0;
+static std::string output;
+
+
+// Logger configuration
+logger_options_t logger_options = {
+    .logging_level = LOG_LVL_DEBUG,
+    .log_format = "[%LVL%] [%FUNC%]: %MSG%",
+    .ansi_styling = false,
+    .process_style_tags = false,
+    .deferred_logging = false,
+    .lock_policy = LOG_LOCK_QUEUE,
+    .lock_timeout_us = 0,
+    .suppress_repeats = false
+};
+
+void check_out_chars(const char* buf, int len) {
+    output.append(buf, len);
+}
+
+stdio_driver_t check_driver = {check_out_chars, nullptr, nullptr, nullptr};
+Logger logger(&check_driver, &logger_options);
+
+
+// Call sites
+struct check_driver_t {
+    void poll() {
+        PICO_LOG_DEBUG(logger, "poll %d", 1);
+    }
+};
+
+template <typename T>
+void check_template(const T value) {
+    PICO_LOG_WARN(logger, "template %d", (int) value);
+}
+
+inline void check_inline() {
+    PICO_LOG_ERROR(logger, "inline");
+}
+
+void check_free() {
+    PICO_LOG_INFO(logger, "free");
+    PICO_LOG_TYPED_INFO(logger, "typed {}", 7);
+}
+
+static void log_all() {
+    check_driver_t().poll();
+    check_template(2);
+    check_template((short) 3);
+    check_inline();
+    check_free();
+}
+
+
+// Compares the output of log_all() with the expected output
+static void check_output(const char* name, const char* expected) {
+    output.clear();
+    log_all();
+
+    if (output != expected) {
+        failures++;
+        printf("FAIL: %s: expected\n%s\ngot\n%s\n", name, expected, output.c_str());
+    }
+}
+
+// Returns the first registered call site in func, or nullptr
+static const log_callsite_t* find_site(const char* func) {
+    for (size_t i = 0; i < log_callsite_count(); i++) {
+        const log_callsite_t* site = log_callsite_get(i);
+
+        if (strcmp(site->func, func) == 0 && strcmp(site->file, __FILE__) == 0) {
+            return site;
+        }
+    }
+
+    return nullptr;
+}
+
+static void check_site(const char* func, const LOG_LEVEL_t level) {
+    const log_callsite_t* site = find_site(func);
+
+    if (site == nullptr || site->level != level) {
+        failures++;
+        printf("FAIL: call site in %s is %s\n", func, (site == nullptr) ? "not registered" : "registered with the wrong level");
+    }
+}
+
+
+int main() {
+    check_output("all enabled",
+                 "[DEBUG] [poll]: poll 1\r\n"
+                 "[WARNING] [check_template]: template 2\r\n"
+                 "[WARNING] [check_template]: template 3\r\n"
+                 "[ERROR] [check_inline]: inline\r\n"
+                 "[INFO] [check_free]: free\r\n"
+                 "[INFO] [check_free]: typed 7\r\n");
+
+    check_site("poll", LOG_LVL_DEBUG);
+    check_site("check_template", LOG_LVL_WARN);
+    check_site("check_inline", LOG_LVL_ERROR);
+    check_site("check_free", LOG_LVL_INFO);
+
+    // Disabled by line: the other call sites of the file stay enabled.
+    const log_callsite_t* poll_site = find_site("poll");
+    const log_callsite_t* inline_site = find_site("check_inline");
+
+    if (poll_site != nullptr && inline_site != nullptr) {
+        log_callsite_set(__FILE__, poll_site->line, LOG_CALLSITE_OFF);
+        log_callsite_set("callsite_check.cpp", inline_site->line, LOG_CALLSITE_OFF);
+
+        check_output("poll and inline disabled",
+                     "[WARNING] [check_template]: template 2\r\n"
+                     "[WARNING] [check_template]: template 3\r\n"
+                     "[INFO] [check_free]: free\r\n"
+                     "[INFO] [check_free]: typed 7\r\n");
+
+        // Forced call sites are output below the logging level.
+        logger_options.logging_level = LOG_LVL_ERROR;
+        log_callsite_set(nullptr, 0, LOG_CALLSITE_ON);
+        log_callsite_set(__FILE__, poll_site->line, LOG_CALLSITE_FORCED);
+
+        check_output("poll forced",
+                     "[DEBUG] [poll]: poll 1\r\n"
+                     "[ERROR] [check_inline]: inline\r\n");
+    }
+
+    printf("%s\n", (failures == 0) ? "All call sites registered and controlled" : "Call-site check failed");
+    return (failures == 0) ? 0 : 1;
+}
\ No newline at end of file
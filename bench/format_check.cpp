@@ -0,0 +1,103 @@
+/*
+    Pico Log - Float formatting check.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+/*
+    Checks the float and double arguments of log_typed() against the host's printf:
+    "%.Nf", or "%.Ne" for values with an integer part that doesn't fit in 64 bits.
+    Exits with a non-zero status if any value is formatted differently.
+*/
+
+#include "pico_log_lib/logger.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+
+static size_t failures = 0;
+static size_t checks = 0;
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+
+// Compares one formatted argument with snprintf()
+static void check(const log_typed_arg_t& arg, const double value) {
+    char expected[400];
+    char actual[400];
+    const bool exp_notation = std::fabs(value) >= 18446744073709551616.0 && !std::isinf(value);
+    snprintf(expected, sizeof(expected), exp_notation ? "%.*e" : "%.*f", arg.digits, value);
+    log_typed_format(actual, sizeof(actual), "{}", &arg, 1, STYLE_TAGS_KEEP);
+    checks++;
+
+    if (strcmp(expected, actual) != 0) {
+        failures++;
+        printf("FAIL: %.17g (%u decimals): expected \"%s\", got \"%s\"\n", value, arg.digits, expected, actual);
+    }
+}
+
+static void check_float(const float value) {
+    check(log_typed_arg(value), value);
+}
+
+static void check_double(const double value) {
+    for (uint8_t decimals = 0; decimals <= 9; decimals++) {
+        check(log_float(value, decimals), value);
+    }
+}
+
+static uint64_t rng_next() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+// Random value with a random magnitude between 1e-12 and 1e18
+static double rng_double() {
+    const double mantissa = (double) (rng_next() >> 11) / 9007199254740992.0;
+    const double value = mantissa * std::pow(10.0, (double) (rng_next() % 31) - 12);
+    return (rng_next() & 1) ? -value : value;
+}
+
+
+int main() {
+    const float floats[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.1f, 0.0005f, 2.5f, 123456.789f, -123456.789f, 3.14159265f,
+                            16777216.0f, 4294967296.0f, 1e19f, -3e18f, 1e20f, -1e20f, 3.4e38f, 1e-10f, INFINITY, -INFINITY};
+    const double doubles[] = {0.0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.0005, 0.125, 0.0625, 9.9995, 9.9999999996, 123456.789,
+                              4294967295.5, 1e15 + 0.3, 9007199254740993.0, 18446744073709549568.0, 18446744073709551616.0,
+                              1e20, -1e20, -3e18, 1.5e19, 9.99999e22, 1e100, -1.7976931348623157e308, 5e-324, INFINITY};
+
+    for (const float value : floats) {
+        check_float(value);
+    }
+
+    for (const double value : doubles) {
+        check_double(value);
+    }
+
+    for (size_t i = 0; i < 20000; i++) {
+        const double value = rng_double();
+        check_double(value);
+        check_float((float) value);
+    }
+
+    printf("%zu of %zu values formatted like printf\n", checks - failures, checks);
+    return (failures == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,385 @@
+/*
+    Pico Log - Host benchmark.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+/*
+    Measures the throughput of the formatting engine on the build host: log format parsing
+    (reparse_format()), and log calls with several log formats, messages (argument counts,
+    style tag densities, compile-time styled and log_typed() messages) and option combinations.
+    Output goes to a sink that only counts the bytes, so only the logger itself is measured.
+    Results are relative: they track regressions between two builds on the same machine,
+    they don't predict the speed on the device (see examples/benchmark for that).
+
+    Usage: pico_log_bench [FILTER] [--time-ms N] [--csv] [--baseline FILE] [--threshold PERCENT]
+    Only cases whose name ("format/message/mode") contains FILTER are run.
+*/
+
+#include "pico_log_lib/logger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef PICO_LOG_STATIC_FORMAT
+#error "The benchmark requires a run-time log format, PICO_LOG_STATIC_FORMAT must not be set."
+#endif
+
+
+// Default minimum measuring time of each case.
+constexpr uint32_t BENCH_DEFAULT_TIME_MS = 50;
+
+// Number of calls between two clock reads, and number of warm-up calls.
+constexpr uint32_t BENCH_BATCH_SIZE = 256;
+
+// Number of deferred messages queued between two drain() calls (all of them fit into the record buffer).
+constexpr uint32_t BENCH_DRAIN_INTERVAL = 8;
+
+// Maximum number of cases in a baseline file.
+constexpr size_t BENCH_MAX_BASELINE = 512;
+
+// Log formats measured.
+struct bench_format {
+    const char* name;
+    const char* format;
+};
+
+constexpr bench_format BENCH_FORMATS[] = {
+    {"msg",     "%MSG%"},
+    {"typical", "[%TSTMP%] [%LVL%] [%FUNC%:%LINE%]: %MSG%"},
+    {"full",    "[%TSTMP%] [%LVL%] [%FILE%:%FUNC%:%LINE%] [%GRN%%BOLD%%TASK%%RST%] [%CORE%]: %MSG%"}
+};
+
+// Option combinations measured.
+struct bench_mode {
+    const char* name;
+    bool ansi_styling;
+    bool process_style_tags;
+    bool deferred_logging;
+};
+
+constexpr bench_mode BENCH_MODES[] = {
+    {"plain",     false, false, false},
+    {"ansi",      true,  false, false},
+    {"tags",      false, true,  false},
+    {"ansi+tags", true,  true,  false},
+    {"deferred",  true,  true,  true}
+};
+
+// Messages measured. Each case logs one message, with arguments derived from the iteration number.
+struct bench_message {
+    const char* name;
+    void (*log)(Logger& logger, const uint32_t iteration);
+};
+
+const char* const BENCH_NAMES[] = {"sensor", "motor", "radio", "battery"};
+
+const bench_message BENCH_MESSAGES[] = {
+    {"text", [](Logger& logger, const uint32_t iteration) {
+        (void) iteration;
+        logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO, "Task heartbeat");
+    }},
+    {"1-arg", [](Logger& logger, const uint32_t iteration) {
+        logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO, "Task heartbeat... iter: %lu", (unsigned long) iteration);
+    }},
+    {"4-args", [](Logger& logger, const uint32_t iteration) {
+        logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO, "%s: %.2f C, iter %lu, state %d", 
+                   BENCH_NAMES[iteration & 3], iteration * 0.25, (unsigned long) iteration, (int) (iteration & 7));
+    }},
+    {"8-args", [](Logger& logger, const uint32_t iteration) {
+        const int i = (int) iteration;
+        logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO, "%d %d %d %d %d %d %d %d", i, -i, i * 3, i >> 1, i & 15, i * 7, -i * 5, i ^ 0x55);
+    }},
+    {"tags-light", [](Logger& logger, const uint32_t iteration) {
+        logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO, "Task 1 heartbeat... iter: %YLW%%lu%RST%, l-exec-t: %RED%%lu%RST%us", 
+                   (unsigned long) iteration, (unsigned long) (iteration % 1000));
+    }},
+    {"tags-heavy", [](Logger& logger, const uint32_t iteration) {
+        logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO, 
+                   "%BOLD%%RED%error%RST% %YLW%%lu%RST% %GRN_HI%ok%RST% %BLU_BG%%s%RST% %UDRLN%line%RST% %ITL%%d%RST% %MGT%end%RST%", 
+                   (unsigned long) iteration, BENCH_NAMES[iteration & 3], (int) (iteration & 7));
+    }},
+    {"styled", [](Logger& logger, const uint32_t iteration) {
+        logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO, PICO_LOG_STYLED("Task 1 heartbeat... iter: %YLW%%lu%RST%, l-exec-t: %RED%%lu%RST%us"), 
+                   (unsigned long) iteration, (unsigned long) (iteration % 1000));
+    }},
+    {"typed", [](Logger& logger, const uint32_t iteration) {
+        logger.log_typed(__func__, __FILE__, __LINE__, LOG_LVL_INFO, "{}: {} C, iter {}, state {}", 
+                         BENCH_NAMES[iteration & 3], iteration * 0.25f, iteration, (int) (iteration & 7));
+    }},
+    {"macro", [](Logger& logger, const uint32_t iteration) {
+        PICO_LOG_INFO(logger, "%s: %.2f C, iter %lu, state %d", 
+                      BENCH_NAMES[iteration & 3], iteration * 0.25, (unsigned long) iteration, (int) (iteration & 7));
+    }}
+};
+
+// Logger configuration
+logger_options_t logger_options = {
+    .logging_level = LOG_LVL_DEBUG,
+    .log_format = "",
+    .ansi_styling = false,
+    .process_style_tags = false,
+    .deferred_logging = false,
+    .lock_policy = LOG_LOCK_QUEUE,
+    .lock_timeout_us = 0,
+    .suppress_repeats = false
+};
+
+// Counts the log output instead of writing it. The last character is read,
+// so the output of segmented messages is still produced.
+uint64_t bench_out_bytes = 0;
+volatile char bench_out_last = 0;
+
+void bench_out_chars(const char* buf, int len) {
+    bench_out_bytes += len;
+
+    if (len > 0) {
+        bench_out_last = buf[len - 1];
+    }
+}
+
+stdio_driver_t bench_driver = {bench_out_chars, nullptr, nullptr, nullptr};
+
+// Command line options.
+struct bench_config {
+    const char* filter = nullptr;
+    uint32_t time_ms = BENCH_DEFAULT_TIME_MS;
+    bool csv = false;
+    const char* baseline_path = nullptr;
+    double threshold = 10.0;
+};
+typedef struct bench_config bench_config_t;
+
+// Result of a previous run (read from a CSV file).
+struct bench_result {
+    char name[64];
+    double ns_per_msg;
+};
+typedef struct bench_result bench_result_t;
+
+bench_result_t baseline[BENCH_MAX_BASELINE];
+size_t baseline_len = 0;
+uint32_t num_regressions = 0;
+
+
+// Returns the current time in nanoseconds.
+static uint64_t bench_time_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Reads the results of a previous run (written with --csv). Returns false if the file can't be read.
+static bool baseline_load(const char* path) {
+    FILE* file = fopen(path, "r");
+    char line[128];
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), file) != nullptr && baseline_len < BENCH_MAX_BASELINE) {
+        bench_result_t& result = baseline[baseline_len];
+
+        if (sscanf(line, "%63[^,],%lf", result.name, &result.ns_per_msg) == 2 && result.ns_per_msg > 0) {
+            baseline_len++;
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+// Returns the baseline time of a case, or 0 if it isn't in the baseline.
+static double baseline_find(const char* name) {
+    for (size_t i = 0; i < baseline_len; i++) {
+        if (strcmp(baseline[i].name, name) == 0) {
+            return baseline[i].ns_per_msg;
+        }
+    }
+
+    return 0;
+}
+
+// Prints the result of a case, compared with the baseline if there is one.
+static void bench_report(const bench_config_t& config, const char* name, const double ns_per_msg, const double bytes_per_msg) {
+    const double bytes_per_sec = (ns_per_msg > 0) ? bytes_per_msg * 1e9 / ns_per_msg : 0;
+
+    if (config.csv) {
+        printf("%s,%.1f,%.0f\n", name, ns_per_msg, bytes_per_sec);
+        return;
+    }
+
+    printf("%-32s %10.1f %10.1f %8.1f", name, ns_per_msg, bytes_per_sec / 1e6, bytes_per_msg);
+
+    const double baseline_ns = baseline_find(name);
+    if (baseline_ns > 0) {
+        const double change = (ns_per_msg - baseline_ns) * 100 / baseline_ns;
+        const bool regression = change > config.threshold;
+        num_regressions += regression;
+        printf(" %+8.1f%%%s", change, regression ? " !" : "");
+    }
+
+    printf("\n");
+}
+
+// Returns true if a case is selected by the filter.
+static bool bench_selected(const bench_config_t& config, const char* name) {
+    return config.filter == nullptr || strstr(name, config.filter) != nullptr;
+}
+
+// Measures reparse_format() (log format parsing) with each log format.
+static void bench_parse(Logger& logger, const bench_config_t& config) {
+    char name[64];
+
+    for (const bench_format& format : BENCH_FORMATS) {
+        snprintf(name, sizeof(name), "%s/parse", format.name);
+
+        if (!bench_selected(config, name)) {
+            continue;
+        }
+
+        logger_options.log_format = format.format;
+        uint64_t iterations = 0;
+        const uint64_t start_ns = bench_time_ns();
+        uint64_t elapsed_ns = 0;
+
+        while (elapsed_ns < config.time_ms * 1000000ull) {
+            for (uint32_t i = 0; i < BENCH_BATCH_SIZE; i++) {
+                logger.reparse_format();
+            }
+
+            iterations += BENCH_BATCH_SIZE;
+            elapsed_ns = bench_time_ns() - start_ns;
+        }
+
+        bench_report(config, name, (double) elapsed_ns / iterations, 0);
+    }
+}
+
+// Measures a message with a log format and option combination.
+static void bench_case(Logger& logger, const bench_config_t& config, const bench_format& format, 
+                       const bench_message& message, const bench_mode& mode) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s/%s/%s", format.name, message.name, mode.name);
+
+    if (!bench_selected(config, name)) {
+        return;
+    }
+
+    logger_options.log_format = format.format;
+    logger_options.ansi_styling = mode.ansi_styling;
+    logger_options.process_style_tags = mode.process_style_tags;
+    logger_options.deferred_logging = mode.deferred_logging;
+    logger.reparse_format();
+
+    // Deferred messages are measured together with their drain() call.
+    auto log_batch = [&](const uint32_t first_iteration) {
+        for (uint32_t i = 0; i < BENCH_BATCH_SIZE; i++) {
+            message.log(logger, first_iteration + i);
+
+            if (mode.deferred_logging && (i + 1) % BENCH_DRAIN_INTERVAL == 0) {
+                logger.drain();
+            }
+        }
+    };
+
+    log_batch(0);
+
+    const uint32_t dropped = logger.get_dropped_records();
+    uint64_t iterations = 0;
+    bench_out_bytes = 0;
+    const uint64_t start_ns = bench_time_ns();
+    uint64_t elapsed_ns = 0;
+
+    while (elapsed_ns < config.time_ms * 1000000ull) {
+        log_batch(iterations);
+        iterations += BENCH_BATCH_SIZE;
+        elapsed_ns = bench_time_ns() - start_ns;
+    }
+
+    if (logger.get_dropped_records() != dropped) {
+        fprintf(stderr, "%s: %lu records dropped, results are not valid\n", name, (unsigned long) (logger.get_dropped_records() - dropped));
+    }
+
+    bench_report(config, name, (double) elapsed_ns / iterations, (double) bench_out_bytes / iterations);
+}
+
+// Parses the command line. Returns false (after printing the usage) if it is invalid.
+static bool bench_parse_args(const int argc, char** argv, bench_config_t& config) {
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--csv") == 0) {
+            config.csv = true;
+        } else if (strcmp(argv[i], "--time-ms") == 0 && has_value) {
+            config.time_ms = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--baseline") == 0 && has_value) {
+            config.baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && has_value) {
+            config.threshold = strtod(argv[++i], nullptr);
+        } else if (argv[i][0] != '-' && config.filter == nullptr) {
+            config.filter = argv[i];
+        } else {
+            fprintf(stderr, "Usage: %s [FILTER] [--time-ms N] [--csv] [--baseline FILE] [--threshold PERCENT]\n", argv[0]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main(int argc, char** argv) {
+    bench_config_t config;
+
+    if (!bench_parse_args(argc, argv, config)) {
+        return 2;
+    }
+
+    if (config.baseline_path != nullptr && !baseline_load(config.baseline_path)) {
+        fprintf(stderr, "Can't read the baseline file %s\n", config.baseline_path);
+        return 2;
+    }
+
+    Logger logger(&bench_driver, &logger_options);
+    logger.init_mutex();
+
+    if (config.csv) {
+        printf("case,ns_per_msg,bytes_per_sec\n");
+    } else {
+        printf("%-32s %10s %10s %8s%s\n", "Case", "ns/msg", "MB/s", "B/msg", (baseline_len > 0) ? "   change" : "");
+    }
+
+    bench_parse(logger, config);
+
+    for (const bench_format& format : BENCH_FORMATS) {
+        for (const bench_message& message : BENCH_MESSAGES) {
+            for (const bench_mode& mode : BENCH_MODES) {
+                bench_case(logger, config, format, message, mode);
+            }
+        }
+    }
+
+    if (num_regressions > 0) {
+        fprintf(stderr, "%lu cases are more than %.1f%% slower than the baseline\n", (unsigned long) num_regressions, config.threshold);
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
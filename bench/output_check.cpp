@@ -0,0 +1,279 @@
+/*
+    Pico Log - Output check.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+/*
+    Checks the bytes written to the sinks against the expected output:
+    - the log format, parsed at run-time, or at compile-time when built with PICO_LOG_STATIC_FORMAT,
+    - styled and plain sinks, with out_chars and with out_segments,
+    - deferred logging (the captured arguments, including truncated strings, must format like the direct call),
+    - messages queued as text while the sinks are busy (LOG_LOCK_QUEUE), including truncated ones,
+    - repeat suppression.
+    Exits with a non-zero status if any check fails.
+*/
+
+#include "pico_log_lib/logger.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+
+// Log format of the check. The PICO_LOG_STATIC_FORMAT build must use the same one.
+#define CHECK_LOG_FORMAT "%BOLD%[%LVL%]%RST% %FUNC%: %MSG%"
+
+#ifdef PICO_LOG_STATIC_FORMAT
+static_assert(std::string_view(PICO_LOG_STATIC_FORMAT) == CHECK_LOG_FORMAT, "PICO_LOG_STATIC_FORMAT must be CHECK_LOG_FORMAT");
+#endif
+
+// ANSI escape codes in the expected output.
+#define BOLD  "\033[1m"
+#define RESET "\033[0m"
+#define RED   "\033[0;31m"
+#define YLW   "\033[0;33m"
+#define BLU   "\033[0;34m"
+
+
+static size_t failures = 0;
+
+// Output of a sink, and the function called to write it.
+struct capture {
+    std::string text;
+    bool segments = false;
+};
+typedef struct capture capture_t;
+
+static void capture_out_chars(void* ctx, const char* buf, size_t len) {
+    static_cast<capture_t*>(ctx)->text.append(buf, len);
+}
+
+static void capture_out_segments(void* ctx, const log_segment_t* segments, size_t num_segments) {
+    capture_t* capture = static_cast<capture_t*>(ctx);
+    capture->segments = true;
+
+    for (size_t i = 0; i < num_segments; i++) {
+        capture->text.append(segments[i].data, segments[i].len);
+    }
+}
+
+
+// Logger configuration
+logger_options_t logger_options = {
+    .logging_level = LOG_LVL_DEBUG,
+    .log_format = CHECK_LOG_FORMAT,
+    .ansi_styling = true,
+    .process_style_tags = true,
+    .deferred_logging = false,
+    .lock_policy = LOG_LOCK_QUEUE,
+    .lock_timeout_us = 0,
+    .suppress_repeats = false
+};
+
+// Styled output with out_chars and plain output with out_segments, and the other way around.
+// Sinks with the same styling are formatted together, and only get segments if all of them support it.
+capture_t styled_chars, plain_segments, styled_segments, plain_chars;
+Logger chars_logger({&styled_chars, capture_out_chars, nullptr}, &logger_options);
+Logger segments_logger({&styled_segments, capture_out_chars, capture_out_segments}, &logger_options);
+
+
+// Compares a capture with the expected output (and the output function used), then clears it
+static void check_capture(const char* name, capture_t& capture, const std::string& expected, const bool segments) {
+    if (capture.text != expected) {
+        failures++;
+        printf("FAIL: %s: expected\n%s\ngot\n%s\n", name, expected.c_str(), capture.text.c_str());
+    }
+
+    if (!expected.empty() && capture.segments != segments) {
+        failures++;
+        printf("FAIL: %s: written with %s\n", name, capture.segments ? "out_segments" : "out_chars");
+    }
+
+    capture = {};
+}
+
+// Checks the styled and plain output of both loggers
+static void check_sinks(const char* name, const std::string& styled, const std::string& plain) {
+    const std::string prefix = name;
+    check_capture((prefix + ", styled out_chars").c_str(), styled_chars, styled, false);
+    check_capture((prefix + ", plain out_segments").c_str(), plain_segments, plain, true);
+    check_capture((prefix + ", styled out_segments").c_str(), styled_segments, styled, true);
+    check_capture((prefix + ", plain out_chars").c_str(), plain_chars, plain, false);
+}
+
+
+// Messages
+static void log_messages(Logger& logger) {
+    PICO_LOG_INFO(logger, "value %d, %u, %x, %c", -42, 42u, 0xBEEFu, 'z');
+    PICO_LOG_WARN(logger, "%RED%red%RST% and %BOLD%%s%RST%", "bold");
+    PICO_LOG_TYPED_INFO(logger, "typed {} {} {}", 7, -1.5f, "text");
+    PICO_LOG_ERROR(logger, "%RED%1%RST%%RED%2%RST%%RED%3%RST%%RED%4%RST%%RED%5%RST%%RED%6%RST%%RED%7%RST%%RED%8%RST%"
+                           "%RED%9%RST%%RED%10%RST%%RED%11%RST%%RED%12%RST% segments %d", 12);
+}
+
+static const char* LOG_MESSAGES_STYLED =
+    BOLD "[" BLU "INFO" RESET "]" RESET " log_messages: value -42, 42, beef, z\r\n"
+    BOLD "[" YLW "WARNING" RESET "]" RESET " log_messages: " RED "red" RESET " and " BOLD "bold" RESET "\r\n"
+    BOLD "[" BLU "INFO" RESET "]" RESET " log_messages: typed 7 -1.500 text\r\n"
+    BOLD "[" RED "ERROR" RESET "]" RESET " log_messages: "
+    RED "1" RESET RED "2" RESET RED "3" RESET RED "4" RESET RED "5" RESET RED "6" RESET RED "7" RESET RED "8" RESET
+    RED "9" RESET RED "10" RESET RED "11" RESET RED "12" RESET " segments 12\r\n";
+
+static const char* LOG_MESSAGES_PLAIN =
+    "[INFO] log_messages: value -42, 42, beef, z\r\n"
+    "[WARNING] log_messages: red and bold\r\n"
+    "[INFO] log_messages: typed 7 -1.500 text\r\n"
+    "[ERROR] log_messages: 123456789101112 segments 12\r\n";
+
+static void log_all(const bool deferred) {
+    logger_options.deferred_logging = deferred;
+    log_messages(chars_logger);
+    log_messages(segments_logger);
+    logger_options.deferred_logging = false;
+}
+
+
+// Strings captured in deferred logging mode are cut at LOGGER_RECORD_MAX_STR_LEN characters
+static void log_string(Logger& logger, const char* str) {
+    PICO_LOG_INFO(logger, "[%s] [%5s] [%.3s]", str, "ab", "xyz123");
+}
+
+static void check_deferred_strings() {
+    const std::string str(LOGGER_RECORD_MAX_STR_LEN + 8, 's');
+    const std::string captured(LOGGER_RECORD_MAX_STR_LEN, 's');
+
+    logger_options.deferred_logging = true;
+    log_string(chars_logger, str.c_str());
+    logger_options.deferred_logging = false;
+    chars_logger.drain();
+    log_string(chars_logger, str.c_str());
+
+    check_capture("deferred strings", styled_chars,
+                  BOLD "[" BLU "INFO" RESET "]" RESET " log_string: [" + captured + "] [   ab] [xyz]\r\n"
+                  BOLD "[" BLU "INFO" RESET "]" RESET " log_string: [" + str + "] [   ab] [xyz]\r\n", false);
+    check_capture("deferred strings, plain", plain_segments,
+                  "[INFO] log_string: [" + captured + "] [   ab] [xyz]\r\n"
+                  "[INFO] log_string: [" + str + "] [   ab] [xyz]\r\n", true);
+}
+
+
+// Messages logged by a sink while it is written to are queued as text, as the log mutex is held
+static bool queue_messages = false;
+capture_t queue_styled, queue_plain;
+
+static void queue_out_chars(void* ctx, const char* buf, size_t len);
+Logger queue_logger({&queue_styled, queue_out_chars, nullptr}, &logger_options);
+
+static void log_queued() {
+    const std::string long_str(LOGGER_RECORD_TEXT_SIZE, 'q');
+    PICO_LOG_INFO(queue_logger, "%RED%queued %d%RST%", 1);
+    PICO_LOG_INFO(queue_logger, "%RED%%s%RST%", long_str.c_str());
+}
+
+static void queue_out_chars(void* ctx, const char* buf, size_t len) {
+    capture_out_chars(ctx, buf, len);
+
+    if (queue_messages) {
+        queue_messages = false;
+        log_queued();
+    }
+}
+
+static void check_queued() {
+    // Truncated messages end with "[...]" (after a reset if they are styled) within LOGGER_RECORD_TEXT_SIZE - 1 characters,
+    // and are reported by the writer once the queue is empty.
+    const size_t cut_len = LOGGER_RECORD_TEXT_SIZE - 1 - strlen("[...]");
+    queue_messages = true;
+    PICO_LOG_INFO(queue_logger, "first");
+
+    check_capture("queued, styled", queue_styled,
+                  BOLD "[" BLU "INFO" RESET "]" RESET " check_queued: first\r\n"
+                  BOLD "[" BLU "INFO" RESET "]" RESET " log_queued: " RED "queued 1" RESET "\r\n"
+                  BOLD "[" BLU "INFO" RESET "]" RESET " log_queued: " RED + 
+                  std::string(cut_len - strlen(RED) - strlen(RESET), 'q') + RESET "[...]\r\n"
+                  BOLD "[" YLW "WARNING" RESET "]" RESET " report_count: 1 messages truncated\r\n", false);
+    check_capture("queued, plain", queue_plain,
+                  "[INFO] check_queued: first\r\n"
+                  "[INFO] log_queued: queued 1\r\n"
+                  "[INFO] log_queued: " + std::string(cut_len, 'q') + "[...]\r\n"
+                  "[WARNING] report_count: 1 messages truncated\r\n", false);
+
+    if (queue_logger.get_truncated_messages() != 1) {
+        failures++;
+        printf("FAIL: %u truncated messages counted, expected 1\n", (unsigned int) queue_logger.get_truncated_messages());
+    }
+}
+
+
+// Identical consecutive messages are collapsed into a "repeated" line, output with the call site of the repeated message
+static void log_repeated(const int value) {
+    PICO_LOG_WARN(chars_logger, "repeated %d", value);
+}
+
+static void check_repeats() {
+    logger_options.suppress_repeats = true;
+
+    for (int i = 0; i < 4; i++) {
+        log_repeated(1);
+    }
+
+    log_repeated(2);
+    log_repeated(2);
+    PICO_LOG_INFO(chars_logger, "done");
+    logger_options.suppress_repeats = false;
+
+    check_capture("repeats", plain_segments,
+                  "[WARNING] log_repeated: repeated 1\r\n"
+                  "[WARNING] log_repeated: Previous message repeated 3 times\r\n"
+                  "[WARNING] log_repeated: repeated 2\r\n"
+                  "[WARNING] log_repeated: Previous message repeated 1 times\r\n"
+                  "[INFO] check_repeats: done\r\n", true);
+    check_capture("repeats, styled", styled_chars,
+                  BOLD "[" YLW "WARNING" RESET "]" RESET " log_repeated: repeated 1\r\n"
+                  BOLD "[" YLW "WARNING" RESET "]" RESET " log_repeated: Previous message repeated 3 times\r\n"
+                  BOLD "[" YLW "WARNING" RESET "]" RESET " log_repeated: repeated 2\r\n"
+                  BOLD "[" YLW "WARNING" RESET "]" RESET " log_repeated: Previous message repeated 1 times\r\n"
+                  BOLD "[" BLU "INFO" RESET "]" RESET " check_repeats: done\r\n", false);
+}
+
+
+int main() {
+    chars_logger.add_sink({&plain_segments, capture_out_chars, capture_out_segments}, LOG_LVL_DEBUG, false);
+    segments_logger.add_sink({&plain_chars, capture_out_chars, nullptr}, LOG_LVL_DEBUG, false);
+    queue_logger.add_sink({&queue_plain, capture_out_chars, nullptr}, LOG_LVL_DEBUG, false);
+    queue_logger.init_mutex();
+
+    log_all(false);
+    check_sinks("direct", LOG_MESSAGES_STYLED, LOG_MESSAGES_PLAIN);
+
+    // Deferred records are only output by drain(), formatted like the direct calls.
+    log_all(true);
+    check_sinks("deferred, before drain()", "", "");
+    chars_logger.drain();
+    segments_logger.drain();
+    check_sinks("deferred", LOG_MESSAGES_STYLED, LOG_MESSAGES_PLAIN);
+
+    check_deferred_strings();
+    check_queued();
+    check_repeats();
+
+    printf("%s\n", (failures == 0) ? "All output matches" : "Output check failed");
+    return (failures == 0) ? 0 : 1;
+}
\ No newline at end of file
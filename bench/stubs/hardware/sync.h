@@ -0,0 +1,51 @@
+/*
+    Pico Log - Host stand-in for hardware/sync.h (benchmark only).
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+
+typedef volatile uint32_t spin_lock_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Spin locks only mask interrupts on the device. The benchmark is single-threaded, so they do nothing.
+int spin_lock_claim_unused(bool required);
+void spin_lock_unclaim(unsigned int lock_num);
+spin_lock_t* spin_lock_instance(unsigned int lock_num);
+unsigned int spin_lock_get_num(spin_lock_t* lock);
+uint32_t spin_lock_blocking(spin_lock_t* lock);
+void spin_unlock(spin_lock_t* lock, uint32_t saved_irq);
+
+static inline void __dmb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __sev(void) {}
+static inline void __wfe(void) {}
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+/*
+    Pico Log - Host stand-in for pico/stdio/driver.h (benchmark only).
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+
+typedef struct stdio_driver {
+    void (*out_chars)(const char* buf, int len);
+    void (*out_flush)(void);
+    int (*in_chars)(char* buf, int len);
+    struct stdio_driver* next;
+} stdio_driver_t;
\ No newline at end of file
@@ -0,0 +1,53 @@
+/*
+    Pico Log - Host stand-in for pico/stdlib.h (benchmark only).
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+typedef uint64_t absolute_time_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Monotonic host time, in microseconds.
+absolute_time_t get_absolute_time(void);
+
+// Always core 0, the benchmark is single-threaded.
+unsigned int get_core_num(void);
+
+static inline uint32_t to_ms_since_boot(const absolute_time_t t) {
+    return (uint32_t) (t / 1000);
+}
+
+static inline uint64_t to_us_since_boot(const absolute_time_t t) {
+    return t;
+}
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+/*
+    Pico Log - Host stand-in for pico/sync.h (benchmark only).
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+
+typedef struct {
+    bool owned;
+} mutex_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Uncontended mutex: the benchmark measures the cost of taking and releasing it, not contention.
+void mutex_init(mutex_t* mtx);
+void mutex_enter_blocking(mutex_t* mtx);
+bool mutex_try_enter(mutex_t* mtx, uint32_t* owner_out);
+bool mutex_enter_timeout_us(mutex_t* mtx, uint32_t timeout_us);
+void mutex_exit(mutex_t* mtx);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*
+    Pico Log - Host implementation of the Pico SDK stand-ins (benchmark only).
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "pico/stdlib.h"
+#include "pico/sync.h"
+#include "pico/multicore.h"
+#include <ctime>
+
+
+// Number of hardware spin locks.
+constexpr unsigned int NUM_SPIN_LOCKS = 32;
+
+static spin_lock_t spin_locks[NUM_SPIN_LOCKS];
+static unsigned int spin_locks_claimed = 0;
+
+
+absolute_time_t get_absolute_time(void) {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+unsigned int get_core_num(void) {
+    return 0;
+}
+
+int spin_lock_claim_unused(bool required) {
+    (void) required;
+    return (int) (spin_locks_claimed++ % NUM_SPIN_LOCKS);
+}
+
+void spin_lock_unclaim(unsigned int lock_num) {
+    (void) lock_num;
+}
+
+spin_lock_t* spin_lock_instance(unsigned int lock_num) {
+    return &spin_locks[lock_num % NUM_SPIN_LOCKS];
+}
+
+unsigned int spin_lock_get_num(spin_lock_t* lock) {
+    return (unsigned int) (lock - spin_locks);
+}
+
+uint32_t spin_lock_blocking(spin_lock_t* lock) {
+    *lock = 1;
+    return 0;
+}
+
+void spin_unlock(spin_lock_t* lock, uint32_t saved_irq) {
+    (void) saved_irq;
+    *lock = 0;
+}
+
+void mutex_init(mutex_t* mtx) {
+    mtx->owned = false;
+}
+
+void mutex_enter_blocking(mutex_t* mtx) {
+    assert(!mtx->owned);
+    mtx->owned = true;
+}
+
+bool mutex_try_enter(mutex_t* mtx, uint32_t* owner_out) {
+    (void) owner_out;
+
+    if (mtx->owned) {
+        return false;
+    }
+
+    mtx->owned = true;
+    return true;
+}
+
+bool mutex_enter_timeout_us(mutex_t* mtx, uint32_t timeout_us) {
+    (void) timeout_us;
+    return mutex_try_enter(mtx, nullptr);
+}
+
+void mutex_exit(mutex_t* mtx) {
+    mtx->owned = false;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    (void) entry;
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+/*
+    Pico Log - Tokenized output check.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+/*
+    Checks the logging macros built with PICO_LOG_TOKENIZED, from the kinds of functions GCC
+    places in different sections: a method defined in a class body, a template,
+    an inline function and a free function, all in the same file.
+    The output frames are decoded (COBS, token ID, timestamp varint and captured arguments),
+    and every token must be found in the pico_log_tokens table.
+    Usage: pico_log_token_check [CAPTURE_FILE], the output is also written to CAPTURE_FILE
+    (for tools/pico_log_decode.py). Exits with a non-zero status if any check fails.
+*/
+
+#include "pico_log_lib/logger.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifndef PICO_LOG_TOKENIZED
+#error "The token check requires PICO_LOG_TOKENIZED."
+#endif
+
+
+// Token table bounds, provided by the linker.
+extern const log_token_t* const __start_pico_log_tokens[];
+extern const log_token_t* const __stop_pico_log_tokens[];
+
+static size_t failures = 0;
+static std::string output;
+
+
+// Logger configuration
+logger_options_t logger_options = {
+    .logging_level = LOG_LVL_DEBUG,
+    .log_format = "[%LVL%] [%FUNC%]: %MSG%",
+    .ansi_styling = false,
+    .process_style_tags = false,
+    .deferred_logging = false,
+    .lock_policy = LOG_LOCK_QUEUE,
+    .lock_timeout_us = 0,
+    .suppress_repeats = false
+};
+
+void check_out_chars(const char* buf, int len) {
+    output.append(buf, len);
+}
+
+stdio_driver_t check_driver = {check_out_chars, nullptr, nullptr, nullptr};
+Logger logger(&check_driver, &logger_options);
+
+
+// Call sites
+struct check_driver_t {
+    void poll() {
+        PICO_LOG_DEBUG(logger, "poll %d", 1);
+    }
+};
+
+template <typename T>
+void check_template(const T value) {
+    PICO_LOG_WARN(logger, "template %d", (int) value);
+}
+
+inline void check_inline() {
+    PICO_LOG_ERROR(logger, "inline %s", "text");
+}
+
+void check_free() {
+    PICO_LOG_INFO(logger, "free");
+    PICO_LOG_TYPED_INFO(logger, "typed {}", 7);
+}
+
+
+// Expected frames: the token format and its captured arguments (strings are prefixed with their length),
+// or the text of a text frame.
+struct check_frame {
+    const char* format;
+    const char* func;
+    std::string args;
+};
+
+static std::string int_arg(const int32_t value) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Returns the token descriptor with the given ID, or nullptr
+static const log_token_t* find_token(const uint32_t id) {
+    for (const log_token_t* const* token = __start_pico_log_tokens; token < __stop_pico_log_tokens; token++) {
+        if ((*token)->id == id) {
+            return *token;
+        }
+    }
+
+    return nullptr;
+}
+
+// Decodes one COBS frame (without its zero byte)
+static std::string cobs_decode(const std::string& frame) {
+    std::string payload;
+    size_t pos = 0;
+
+    while (pos < frame.size()) {
+        const uint8_t code = frame[pos++];
+
+        for (uint8_t i = 1; i < code && pos < frame.size(); i++) {
+            payload += frame[pos++];
+        }
+
+        if (code != 0xFF && pos < frame.size()) {
+            payload += '\0';
+        }
+    }
+
+    return payload;
+}
+
+static uint64_t varint_decode(const std::string& payload, size_t& pos) {
+    uint64_t value = 0;
+
+    for (uint32_t shift = 0; pos < payload.size(); shift += 7) {
+        const uint8_t byte = payload[pos++];
+        value |= (uint64_t) (byte & 0x7F) << shift;
+
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+
+    return value;
+}
+
+static void check_frame_at(const size_t index, const std::string& payload, const check_frame& expected) {
+    uint32_t id;
+    memcpy(&id, payload.data(), sizeof(id));
+
+    if (id == LOG_TOKEN_TEXT) {
+        if (payload.substr(sizeof(id)) != expected.args) {
+            failures++;
+            printf("FAIL: frame %zu: expected text \"%s\", got \"%s\"\n", index, expected.args.c_str(), payload.c_str() + sizeof(id));
+        }
+        return;
+    }
+
+    const log_token_t* token = find_token(id);
+
+    if (token == nullptr || strcmp(token->format, expected.format) != 0 || strcmp(token->func, expected.func) != 0) {
+        failures++;
+        printf("FAIL: frame %zu: token %08x is not the one of \"%s\"\n", index, (unsigned int) id, expected.format);
+        return;
+    }
+
+    // Only the first record has an absolute timestamp
+    size_t pos = sizeof(id);
+    const uint64_t timestamp = varint_decode(payload, pos);
+
+    if ((timestamp & 1) != (index == 0) || payload.substr(pos) != expected.args) {
+        failures++;
+        printf("FAIL: frame %zu (\"%s\"): wrong timestamp type or arguments\n", index, expected.format);
+    }
+}
+
+
+int main(int argc, char** argv) {
+    check_driver_t().poll();
+    check_template(2);
+    check_template((short) 3);
+    check_inline();
+    check_free();
+
+    const check_frame expected[] = {
+        {"poll %d", "poll", int_arg(1)},
+        {"template %d", "check_template", int_arg(2)},
+        {"template %d", "check_template", int_arg(3)},
+        {"inline %s", "check_inline", std::string("\x04text")},
+        {"free", "check_free", ""},
+        {nullptr, nullptr, "[INFO] [check_free]: typed 7\r\n"}
+    };
+    const size_t num_expected = sizeof(expected) / sizeof(expected[0]);
+
+    size_t index = 0;
+    size_t start = 0;
+
+    for (size_t end = output.find('\0'); end != std::string::npos; end = output.find('\0', start)) {
+        if (index < num_expected) {
+            check_frame_at(index, cobs_decode(output.substr(start, end - start)), expected[index]);
+        }
+
+        index++;
+        start = end + 1;
+    }
+
+    if (index != num_expected || start != output.size()) {
+        failures++;
+        printf("FAIL: expected %zu frames, got %zu\n", num_expected, index);
+    }
+
+    if (argc > 1) {
+        FILE* file = fopen(argv[1], "wb");
+
+        if (file == nullptr || fwrite(output.data(), 1, output.size(), file) != output.size()) {
+            failures++;
+            printf("FAIL: can't write %s\n", argv[1]);
+        }
+
+        if (file != nullptr) {
+            fclose(file);
+        }
+    }
+
+    printf("%s\n", (failures == 0) ? "All tokenized frames decoded" : "Token check failed");
+    return (failures == 0) ? 0 : 1;
+}
\ No newline at end of file
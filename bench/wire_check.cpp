@@ -0,0 +1,158 @@
+/*
+    Pico Log - Wire format check.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+/*
+    Checks the encoding of tokenized records (see tokens.h) against known byte sequences:
+    varints, timestamps and COBS frames, and decodes COBS frames of every length up to a few
+    blocks of 254 bytes back into their payload.
+    Exits with a non-zero status if any check fails.
+*/
+
+#include "pico_log_lib/internal/tokens.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+static size_t failures = 0;
+static size_t checks = 0;
+
+
+// Compares encoded bytes with the expected ones
+static void check_bytes(const char* name, const uint8_t* actual, const size_t actual_len, const std::vector<uint8_t>& expected) {
+    checks++;
+
+    if (actual_len != expected.size() || memcmp(actual, expected.data(), actual_len) != 0) {
+        failures++;
+        printf("FAIL: %s: expected", name);
+
+        for (const uint8_t byte : expected) {
+            printf(" %02X", byte);
+        }
+
+        printf(", got");
+
+        for (size_t i = 0; i < actual_len; i++) {
+            printf(" %02X", actual[i]);
+        }
+
+        printf("\n");
+    }
+}
+
+static void check_varint(const uint64_t value, const std::vector<uint8_t>& expected) {
+    uint8_t encoded[LOG_WIRE_VARINT_MAX_LEN];
+    char name[48];
+    snprintf(name, sizeof(name), "varint %llu", (unsigned long long) value);
+    check_bytes(name, encoded, log_wire_varint(value, encoded), expected);
+}
+
+static void check_timestamp(const uint32_t timestamp_ms, const uint32_t last_ms, const bool absolute, const uint64_t expected) {
+    checks++;
+
+    if (log_wire_timestamp(timestamp_ms, last_ms, absolute) != expected) {
+        failures++;
+        printf("FAIL: timestamp %u (last %u, %s): expected %llu\n", timestamp_ms, last_ms, absolute ? "absolute" : "delta",
+               (unsigned long long) expected);
+    }
+}
+
+static void check_cobs(const std::vector<uint8_t>& payload, const std::vector<uint8_t>& expected) {
+    uint8_t encoded[log_wire_frame_len(16)];
+    char name[48];
+    snprintf(name, sizeof(name), "COBS of %zu bytes", payload.size());
+    check_bytes(name, encoded, log_wire_cobs(payload.data(), payload.size(), encoded), expected);
+}
+
+// Decodes a COBS frame (without its zero byte), as tools/pico_log_decode.py does
+static std::vector<uint8_t> cobs_decode(const uint8_t* frame, const size_t len) {
+    std::vector<uint8_t> payload;
+    size_t pos = 0;
+
+    while (pos < len) {
+        const uint8_t code = frame[pos++];
+        payload.insert(payload.end(), frame + pos, frame + pos + code - 1);
+        pos += code - 1;
+
+        if (code < 0xFF && pos < len) {
+            payload.push_back(0);
+        }
+    }
+
+    return payload;
+}
+
+// Encodes payloads of every length up to max_len (with zero bytes at different positions),
+// and checks that they decode back, without zero bytes, within log_wire_frame_len()
+static void check_cobs_round_trip(const size_t max_len) {
+    std::vector<uint8_t> encoded(log_wire_frame_len(max_len));
+
+    for (size_t len = 0; len <= max_len; len++) {
+        for (const size_t zero_interval : {0, 1, 7, 300}) {
+            std::vector<uint8_t> payload(len);
+
+            for (size_t i = 0; i < len; i++) {
+                payload[i] = (zero_interval != 0 && i % zero_interval == 0) ? 0 : (uint8_t) (i % 255 + 1);
+            }
+
+            const size_t encoded_len = log_wire_cobs(payload.data(), len, encoded.data());
+            checks++;
+
+            if (encoded_len + 1 > log_wire_frame_len(len) || memchr(encoded.data(), 0, encoded_len) != nullptr ||
+                cobs_decode(encoded.data(), encoded_len) != payload) {
+                failures++;
+                printf("FAIL: COBS round trip of %zu bytes (zero every %zu)\n", len, zero_interval);
+            }
+        }
+    }
+}
+
+
+int main() {
+    check_varint(0, {0x00});
+    check_varint(1, {0x01});
+    check_varint(127, {0x7F});
+    check_varint(128, {0x80, 0x01});
+    check_varint(300, {0xAC, 0x02});
+    check_varint(UINT32_MAX, {0xFF, 0xFF, 0xFF, 0xFF, 0x0F});
+    check_varint(UINT64_MAX, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01});
+
+    // Absolute: (ms << 1) | 1, delta: zigzag(delta) << 1
+    check_timestamp(1000, 0, true, 2001);
+    check_timestamp(UINT32_MAX, 0, true, 8589934591ULL);
+    check_timestamp(1005, 1000, false, 20);
+    check_timestamp(995, 1000, false, 18);
+    check_timestamp(1000, 1000, false, 0);
+    check_timestamp(2, UINT32_MAX, false, 12);
+
+    check_cobs({}, {0x01});
+    check_cobs({0x00}, {0x01, 0x01});
+    check_cobs({0x00, 0x00}, {0x01, 0x01, 0x01});
+    check_cobs({0x11, 0x22, 0x00, 0x33}, {0x03, 0x11, 0x22, 0x02, 0x33});
+    check_cobs({0x11, 0x22, 0x33, 0x44}, {0x05, 0x11, 0x22, 0x33, 0x44});
+    check_cobs({0x11, 0x00, 0x00, 0x00}, {0x02, 0x11, 0x01, 0x01, 0x01});
+
+    check_cobs_round_trip(3 * 254 + 2);
+
+    printf("%zu of %zu wire format checks passed\n", checks - failures, checks);
+    return (failures == 0) ? 0 : 1;
+}
\ No newline at end of file
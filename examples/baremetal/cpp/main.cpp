@@ -30,12 +30,16 @@ logger_options_t logger_options = {
     .logging_level = LOG_LVL_DEBUG,
     .log_format = "[%TSTMP%] [%LVL%] [%FUNC%:%LINE%] [%GRN%%BOLD%%CORE%%RST%]: %MSG%",
     .ansi_styling = true,
-    .process_style_tags = true  
+    .process_style_tags = true,
+    .deferred_logging = false,
+    .lock_policy = LOG_LOCK_QUEUE,
+    .lock_timeout_us = 0,
+    .suppress_repeats = false
 };
 
 // Logger initialization with USB stdio driver & logging macro
 Logger logger(&stdio_usb, &logger_options);
-#define LOG(lvl, msg, ...) logger.log(__func__, __FILE__, __LINE__, lvl, msg, ##__VA_ARGS__);
+#define LOG(lvl, ...) PICO_LOG(logger, lvl, __VA_ARGS__);
 
 // Core 1 logger
 void core1_entry() {
@@ -44,7 +48,7 @@ void core1_entry() {
     
     while (true) {
         start_time = time_us_32();
-        LOG(LOG_LVL_FATAL, "Core 1 heartbeat... iter: %YLW%%u%RST%, l-exec-t: %RED%%u%RST%us", counter, elapsed_time)
+        LOG(FATAL, "Core 1 heartbeat... iter: %YLW%%u%RST%, l-exec-t: %RED%%u%RST%us", counter, elapsed_time)
         elapsed_time = (time_us_32() - start_time);
         sleep_ms(2000);
         counter++;
@@ -58,7 +62,7 @@ void core0_entry() {
 
     while (true) {
         start_time = time_us_32();
-        LOG(LOG_LVL_DEBUG, "Core 0 heartbeat... iter: %YLW%%u%RST%, l-exec-t: %RED%%u%RST%us", counter, elapsed_time)
+        LOG(DEBUG, "Core 0 heartbeat... iter: %YLW%%u%RST%, l-exec-t: %RED%%u%RST%us", counter, elapsed_time)
         elapsed_time = (time_us_32() - start_time);
         sleep_ms(1000);
         counter++;
@@ -75,21 +79,21 @@ int main() {
     }
     
     // Example: logging before mutex initialization
-    LOG(LOG_LVL_DEBUG, "This is a %CYN%debug%RST% message.")
-    LOG(LOG_LVL_INFO, "Info level log with %GRN%color%RST%.")
-    LOG(LOG_LVL_WARN, "This is a warning. %YLW%Very yellow.%RST%")
-    LOG(LOG_LVL_ERROR, "%RED%Error encountered!%RST%")
-    LOG(LOG_LVL_FATAL, "%MGT%Fatal situation!%RST%")
-    LOG(LOG_LVL_INFO, "To %BOLD%boldly go%RST% where %UDRLN%no one%RST% has gone before.")
-    LOG(LOG_LVL_INFO, "%ITL%This is italic text%RST%.")
-    LOG(LOG_LVL_INFO, "%STKTHR%This is strikethrough text%RST%.")
-    LOG(LOG_LVL_INFO, "%BLU_BG%Background colors!%RST%")
+    LOG(DEBUG, "This is a %CYN%debug%RST% message.")
+    LOG(INFO, "Info level log with %GRN%color%RST%.")
+    LOG(WARN, "This is a warning. %YLW%Very yellow.%RST%")
+    LOG(ERROR, "%RED%Error encountered!%RST%")
+    LOG(FATAL, "%MGT%Fatal situation!%RST%")
+    LOG(INFO, "To %BOLD%boldly go%RST% where %UDRLN%no one%RST% has gone before.")
+    LOG(INFO, "%ITL%This is italic text%RST%.")
+    LOG(INFO, "%STKTHR%This is strikethrough text%RST%.")
+    LOG(INFO, "%BLU_BG%Background colors!%RST%")
 
     // Initialize logger mutex to ensure thread safety (not really threads, but cores)
     assert(logger.init_mutex());
     
     // Launch core 1
-    LOG(LOG_LVL_INFO, "Launching core 1...");
+    LOG(INFO, "Launching core 1...");
     multicore_launch_core1(core1_entry);
     
     // Core 0 loop
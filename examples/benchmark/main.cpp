@@ -0,0 +1,176 @@
+/*
+    Pico Log - Benchmark
+    A fast logging library for RP2xxx microcontrollers.
+    
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+ 
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+ 
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+ 
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https: www.gnu.org/licenses/>.
+*/
+
+/*
+    Measures the number of CPU cycles taken by the logger to format
+    a message with each of the log format tokens, and to format message
+    arguments with vsnprintf() (log()) and with log_typed().
+    Log output is discarded, so the stdio driver's speed doesn't affect the results.
+    It uses log_typed(), log_hex() and the current logger options, so it doesn't build against
+    older versions of the library. Compare builds of the same tree instead (e.g. with different options).
+*/
+
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#include "pico_log_lib/logger.h"
+#include <cstdio>
+
+#ifdef PICO_LOG_STATIC_FORMAT
+#error "The benchmark requires a run-time log format, PICO_LOG_STATIC_FORMAT must not be set."
+#endif
+
+
+// Number of log() calls per measurement.
+constexpr uint32_t BENCH_ITERATIONS = 2000;
+
+// Stores the average number of cycles of a statement in result.
+// SysTick counts down from 0xFFFFFF.
+#define BENCH_CYCLES(result, statement)                                       \
+    {                                                                         \
+        uint64_t total_cycles = 0;                                            \
+        for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {                     \
+            const uint32_t start_cycles = systick_hw->cvr;                    \
+            statement;                                                        \
+            total_cycles += (start_cycles - systick_hw->cvr) & 0x00FFFFFF;    \
+        }                                                                     \
+        result = total_cycles / BENCH_ITERATIONS;                             \
+    }
+
+// Log formats measured. The cost of each token is measured against the empty format.
+struct bench_format {
+    const char* name;
+    const char* format;
+};
+
+constexpr bench_format BENCH_FORMATS[] = {
+    {"(empty)", ""},
+    {"text",    "[text]"},
+    {"%LINE%",  "%LINE%"},
+    {"%TSTMP%", "%TSTMP%"},
+    {"%RED%",   "%RED%"},
+    {"%BOLD%",  "%BOLD%"},
+    {"%LVL%",   "%LVL%"},
+    {"%FILE%",  "%FILE%"},
+    {"%FUNC%",  "%FUNC%"},
+    {"%CORE%",  "%CORE%"},
+    {"%MSG%",   "%MSG%"},
+    {"(full)",  "[%TSTMP%] [%LVL%] [%FUNC%:%LINE%] [%GRN%%BOLD%%CORE%%RST%]: %MSG%"}
+};
+
+// Logger configuration
+logger_options_t logger_options = {
+    .logging_level = LOG_LVL_DEBUG,
+    .log_format = "",
+    .ansi_styling = true,
+    .process_style_tags = false,
+    .deferred_logging = false,
+    .lock_policy = LOG_LOCK_QUEUE,
+    .lock_timeout_us = 0,
+    .suppress_repeats = false
+};
+
+// Discards log output.
+void null_out_chars(const char* buf, int len) {
+    (void) buf;
+    (void) len;
+}
+
+stdio_driver_t null_driver = {};
+
+
+// Returns the average number of cycles of a log() call with the given log format.
+uint32_t bench_log_format(Logger& logger, const char* format) {
+    uint32_t cycles;
+    
+    logger_options.log_format = format;
+    logger.reparse_format();
+
+    BENCH_CYCLES(cycles, logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO, "Hello world!"));
+    return cycles;
+}
+
+// Prints the average number of cycles of the same message logged with log() and with log_typed().
+// The message and arguments of each call are given in parentheses.
+#define BENCH_UNPACK(...) __VA_ARGS__
+#define BENCH_MESSAGE(name, printf_args, typed_args)                                                        \
+    {                                                                                                       \
+        uint32_t printf_cycles, typed_cycles;                                                               \
+        BENCH_CYCLES(printf_cycles, logger.log(__func__, __FILE__, __LINE__, LOG_LVL_INFO,                   \
+                                               BENCH_UNPACK printf_args));                                  \
+        BENCH_CYCLES(typed_cycles, logger.log_typed(__func__, __FILE__, __LINE__, LOG_LVL_INFO,              \
+                                                    BENCH_UNPACK typed_args));                              \
+        printf("%-10s %10lu %10lu\n", name, (unsigned long) printf_cycles, (unsigned long) typed_cycles);   \
+    }
+
+// Compares the argument formatting costs of log() and log_typed().
+void bench_log_messages(Logger& logger) {
+    const char* name = "sensor";
+    const float temperature = 23.75f;
+    const int32_t offset = -1250;
+    const uint32_t id = 0xC0FFEE;
+
+    logger_options.log_format = "%MSG%";
+    logger.reparse_format();
+
+    printf("\n%-10s %10s %10s\n", "Message", "log()", "log_typed()");
+
+    BENCH_MESSAGE("int",    ("%ld", (long) offset),                  ("{}", offset));
+    BENCH_MESSAGE("hex",    ("%08lx", (unsigned long) id),           ("{}", log_hex(id, 8)));
+    BENCH_MESSAGE("string", ("%s", name),                            ("{}", name));
+    BENCH_MESSAGE("float",  ("%.3f", temperature),                   ("{}", temperature));
+    BENCH_MESSAGE("mixed",  ("%s: %.3f C (offset %ld)", name, temperature, (long) offset), 
+                            ("{}: {} C (offset {})", name, temperature, offset));
+}
+
+
+int main() {
+    stdio_init_all();
+    
+    // Wait for USB connection
+    while (!stdio_usb_connected()) {
+        sleep_ms(100);
+    }
+
+    null_driver.out_chars = null_out_chars;
+    Logger logger(&null_driver, &logger_options);
+
+    // SysTick: processor clock, free-running 24-bit counter
+    systick_hw->csr = 0;
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+
+    while (true) {
+        const uint32_t empty_cycles = bench_log_format(logger, BENCH_FORMATS[0].format);
+        printf("\n%-10s %10s %10s\n", "Token", "Cycles", "Token cost");
+
+        for (const bench_format& bench : BENCH_FORMATS) {
+            const uint32_t cycles = bench_log_format(logger, bench.format);
+            printf("%-10s %10lu %10ld\n", bench.name, (unsigned long) cycles, (long) cycles - (long) empty_cycles);
+        }
+
+        bench_log_messages(logger);
+
+        sleep_ms(5000);
+    }
+
+    return 0;
+}
\ No newline at end of file
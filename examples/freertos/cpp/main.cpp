@@ -42,12 +42,16 @@ logger_options_t logger_options = {
     .logging_level = LOG_LVL_DEBUG,
     .log_format = "[%TSTMP%] [%LVL%] [%FUNC%:%LINE%]: %MSG%",
     .ansi_styling = true,
-    .process_style_tags = true  
+    .process_style_tags = true,
+    .deferred_logging = false,
+    .lock_policy = LOG_LOCK_QUEUE,
+    .lock_timeout_us = 0,
+    .suppress_repeats = false
 };
 
 // Logger initialization with USB stdio driver & logging macro
 Logger logger(&stdio_usb, &logger_options);
-#define LOG(lvl, msg, ...) logger.log(__func__, __FILE__, __LINE__, lvl, msg, ##__VA_ARGS__);
+#define LOG(lvl, ...) PICO_LOG(logger, lvl, __VA_ARGS__);
 
 // Multi-threaded logging example
 void log_task1(void* arg) {
@@ -57,7 +61,7 @@ void log_task1(void* arg) {
 
     while (true) {
         start_time = time_us_32();
-        LOG(LOG_LVL_DEBUG, "Task 1 heartbeat... iter: %YLW%%u%RST%, l-exec-t: %RED%%u%RST%us", counter, elapsed_time)
+        LOG(DEBUG, "Task 1 heartbeat... iter: %YLW%%u%RST%, l-exec-t: %RED%%u%RST%us", counter, elapsed_time)
         elapsed_time = (time_us_32() - start_time);
         vTaskDelay(pdMS_TO_TICKS(1000));
         counter++;
@@ -71,7 +75,7 @@ void log_task2(void* arg) {
     
     while (true) {
         start_time = time_us_32();
-        LOG(LOG_LVL_FATAL, "Task 2 heartbeat... iter: %YLW%%u%RST%, l-exec-t: %RED%%u%RST%us", counter, elapsed_time)
+        LOG(FATAL, "Task 2 heartbeat... iter: %YLW%%u%RST%, l-exec-t: %RED%%u%RST%us", counter, elapsed_time)
         elapsed_time = (time_us_32() - start_time);
         vTaskDelay(pdMS_TO_TICKS(2000));
         counter++;
@@ -88,15 +92,15 @@ int main() {
     }
 
     // Example: logging before mutex initialization
-    LOG(LOG_LVL_DEBUG, "This is a %CYN%debug%RST% message.")
-    LOG(LOG_LVL_INFO, "Info level log with %GRN%color%RST%.")
-    LOG(LOG_LVL_WARN, "This is a warning. %YLW%Very yellow.%RST%")
-    LOG(LOG_LVL_ERROR, "%RED%Error encountered!%RST%")
-    LOG(LOG_LVL_FATAL, "%MGT%Fatal situation!%RST%")
-    LOG(LOG_LVL_INFO, "To %BOLD%boldly go%RST% where %UDRLN%no one%RST% has gone before.")
-    LOG(LOG_LVL_INFO, "%ITL%This is italic text%RST%.")
-    LOG(LOG_LVL_INFO, "%STKTHR%This is strikethrough text%RST%.")
-    LOG(LOG_LVL_INFO, "%BLU_BG%Background colors!%RST%")
+    LOG(DEBUG, "This is a %CYN%debug%RST% message.")
+    LOG(INFO, "Info level log with %GRN%color%RST%.")
+    LOG(WARN, "This is a warning. %YLW%Very yellow.%RST%")
+    LOG(ERROR, "%RED%Error encountered!%RST%")
+    LOG(FATAL, "%MGT%Fatal situation!%RST%")
+    LOG(INFO, "To %BOLD%boldly go%RST% where %UDRLN%no one%RST% has gone before.")
+    LOG(INFO, "%ITL%This is italic text%RST%.")
+    LOG(INFO, "%STKTHR%This is strikethrough text%RST%.")
+    LOG(INFO, "%BLU_BG%Background colors!%RST%")
 
     // Example: changing the log format after initialization
     logger_options.log_format = "[%TSTMP%] [%LVL%] [%GRN%%BOLD%%TASK%%RST%:%FUNC%] [%CORE%]: %MSG%";
@@ -0,0 +1,101 @@
+/*
+    Pico Log - Log call-site registry.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+#include "pico_log_lib/internal/macros.h"
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Call-site states.
+typedef enum {
+    LOG_CALLSITE_OFF,   // Disabled, the logger is not called at all.
+    LOG_CALLSITE_ON,    // Enabled, messages are filtered by log level (default).
+    LOG_CALLSITE_FORCED // Enabled regardless of log level.
+} LOG_CALLSITE_STATE_t;
+
+// Call-site descriptor. Descriptors are constant (stored in flash),
+// only the state byte they point to is stored in RAM.
+typedef struct {
+    const char* func;
+    const char* file;
+    volatile uint8_t* state;
+    uint16_t line;
+    uint8_t level;
+} log_callsite_t;
+
+
+/*
+    Registers a log call site in the pico_log_callsites linker table
+    and evaluates call if the call site is not disabled.
+    call can reference the call-site descriptor as pico_log_site.
+    The disabled check is a single byte test, done before the logger is called.
+*/
+#define PICO_LOG_CALLSITE(lvl, call)                                                                                   \
+    __extension__ ({                                                                                                   \
+        static volatile uint8_t pico_log_site_state = LOG_CALLSITE_ON;                                                 \
+        static const log_callsite_t pico_log_site =                                                                    \
+            {__func__, __FILE__, &pico_log_site_state, __LINE__, (uint8_t) (lvl)};                                     \
+        PICO_LOG_TABLE_ENTRY("pico_log_callsites", &pico_log_site);                                                    \
+        if (pico_log_site_state != LOG_CALLSITE_OFF) {                                                                 \
+            call;                                                                                                      \
+        }                                                                                                              \
+    })
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /**
+     * @brief Returns the number of registered log call sites.
+     *
+     * Only call sites of the logging macros compiled with PICO_LOG_CALLSITES are registered.
+     * Call sites in inline functions and templates can be listed once per copy of the code
+     * that the compiler emitted, all copies share the same descriptor.
+     *
+     * @return The number of call-site descriptors in the pico_log_callsites table.
+     */
+    size_t log_callsite_count(void);
+
+    /**
+     * @brief Returns a registered log call site.
+     *
+     * @param index Call-site index, less than log_callsite_count().
+     * @return The call-site descriptor or NULL if the index is out of range.
+     */
+    const log_callsite_t* log_callsite_get(const size_t index);
+
+    /**
+     * @brief Sets the state of matching log call sites.
+     *
+     * Files are matched by name only (the part after the last path separator),
+     * so the same names as for per-module log levels can be used.
+     *
+     * @param file Source file name of the call sites, or NULL for all files.
+     * @param line Line number of the call site, or 0 for all lines.
+     * @param state New state of the matching call sites.
+     * @return The number of call sites changed.
+     */
+    size_t log_callsite_set(const char* file, const uint16_t line, const LOG_CALLSITE_STATE_t state);
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
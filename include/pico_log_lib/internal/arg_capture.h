@@ -0,0 +1,57 @@
+/*
+    Pico Log - Deferred argument capture.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "pico_log_lib/internal/style_tags.h"
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+
+// Maximum number of characters copied for each string (%s) argument.
+// Longer strings are truncated when the arguments are captured.
+#ifndef LOGGER_RECORD_MAX_STR_LEN
+    #define LOGGER_RECORD_MAX_STR_LEN 32
+#endif
+
+
+/*
+    Copies the raw values of the arguments referenced by a printf-style
+    format string from a va_list into a byte buffer. Strings are copied by value.
+    Style tags are skipped if skip_style_tags is true.
+    Returns the number of bytes written to the buffer.
+*/
+size_t log_args_capture(const char* format, va_list args, uint8_t* buff, const size_t buff_size, const bool skip_style_tags);
+
+/*
+    vsnprintf() equivalent that takes its arguments from a buffer filled by log_args_capture().
+    Style tags are handled according to style_tags.
+    The output is always null-terminated. Formatting stops at the first argument
+    that could not be captured. Returns the number of characters written.
+*/
+size_t log_args_vsnprintf(char* buff, const size_t buff_size, const char* format, const uint8_t* args, const size_t args_len, 
+                          const STYLE_TAG_MODE style_tags);
+
+/*
+    vsnprintf() equivalent that replaces style tags with their ANSI escape codes (or removes them) while formatting.
+    The output is always null-terminated. Returns the number of characters written.
+*/
+size_t log_vsnprintf_styled(char* buff, const size_t buff_size, const char* format, va_list args, const STYLE_TAG_MODE style_tags);
\ No newline at end of file
@@ -0,0 +1,215 @@
+/*
+    Pico Log - Buffer writers.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "pico_log_lib/internal/style_tags.h"
+#include "pico_log_lib/sink.h"
+#include <array>
+#include <cstring>
+
+
+// Appends up to len characters of str to buff, always leaving space for the null-terminator.
+static inline void buff_append(char* buff, const size_t buff_size, size_t& buff_pos, const char* str, size_t len) {
+    if (buff_pos + 1 >= buff_size) {
+        return;
+    }
+
+    if (len > buff_size - buff_pos - 1) {
+        len = buff_size - buff_pos - 1;
+    }
+
+    memcpy(buff + buff_pos, str, len);
+    buff_pos += len;
+}
+
+// Appends a null-terminated string to buff, always leaving space for the null-terminator.
+static inline void buff_concat(char* buff, const size_t buff_size, size_t& buff_pos, const char* str) {
+    if (buff_pos + 1 < buff_size) {
+        buff_append(buff, buff_size, buff_pos, str, strnlen(str, buff_size - buff_pos - 1));
+    }
+}
+
+// Two-digit decimal lookup table ("00", "01", ..., "99").
+constexpr std::array<char, 200> DIGIT_PAIRS = [] {
+    std::array<char, 200> digit_pairs = {};
+
+    for (size_t i = 0; i < 100; i++) {
+        digit_pairs[i * 2]     = '0' + i / 10;
+        digit_pairs[i * 2 + 1] = '0' + i % 10;
+    }
+
+    return digit_pairs;
+}();
+
+// Hexadecimal digits.
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+// Writes the decimal digits of value (zero-padded to min_digits) to str, without a null-terminator.
+// str must have space for 10 characters. Returns the number of digits written.
+static inline size_t uint_to_str(uint32_t value, char* str, const size_t min_digits) {
+    char digits[10];
+    size_t digit_pos = sizeof(digits);
+
+    // Two digits per division
+    while (value >= 100) {
+        const uint32_t pair_idx = (value % 100) * 2;
+        value /= 100;
+        digits[--digit_pos] = DIGIT_PAIRS[pair_idx + 1];
+        digits[--digit_pos] = DIGIT_PAIRS[pair_idx];
+    }
+
+    if (value >= 10) {
+        digits[--digit_pos] = DIGIT_PAIRS[value * 2 + 1];
+        digits[--digit_pos] = DIGIT_PAIRS[value * 2];
+    } else {
+        digits[--digit_pos] = '0' + value;
+    }
+
+    while (sizeof(digits) - digit_pos < min_digits) {
+        digits[--digit_pos] = '0';
+    }
+
+    memcpy(str, digits + digit_pos, sizeof(digits) - digit_pos);
+    return sizeof(digits) - digit_pos;
+}
+
+// Writes the decimal digits of a 64-bit value to str, without a null-terminator.
+// str must have space for 20 characters. Returns the number of digits written.
+static inline size_t uint64_to_str(uint64_t value, char* str) {
+    if (value <= UINT32_MAX) {
+        return uint_to_str(value, str, 1);
+    }
+
+    // Split into 32-bit parts of 9 digits, only the upper part needs a 64-bit division.
+    const uint64_t upper = value / 1000000000;
+    const size_t upper_len = uint64_to_str(upper, str);
+    return upper_len + uint_to_str(value - upper * 1000000000, str + upper_len, 9);
+}
+
+// Writes the hexadecimal digits of value (zero-padded to min_digits) to str, without a null-terminator.
+// str must have space for 16 characters. Returns the number of digits written.
+static inline size_t uint_to_hex(uint64_t value, char* str, const size_t min_digits) {
+    char digits[16];
+    size_t digit_pos = sizeof(digits);
+
+    do {
+        digits[--digit_pos] = HEX_DIGITS[value & 0xF];
+        value >>= 4;
+    } while (value != 0);
+
+    while (sizeof(digits) - digit_pos < min_digits && digit_pos > 0) {
+        digits[--digit_pos] = '0';
+    }
+
+    memcpy(str, digits + digit_pos, sizeof(digits) - digit_pos);
+    return sizeof(digits) - digit_pos;
+}
+
+// Appends the decimal digits of value (zero-padded to min_digits) to buff.
+static inline void buff_write_uint(char* buff, const size_t buff_size, size_t& buff_pos, const uint32_t value, const size_t min_digits) {
+    char str[10];
+    buff_append(buff, buff_size, buff_pos, str, uint_to_str(value, str, min_digits));
+}
+
+// Appends the (pre-rendered) ANSI escape code of a color code to buff.
+static inline void buff_write_color(char* buff, const size_t buff_size, size_t& buff_pos, const uint8_t color_code) {
+    const style_escape_t& escape = style_color_escape(color_code);
+    buff_append(buff, buff_size, buff_pos, escape.str, escape.len);
+}
+
+
+// Formatted message output. Dynamic parts are written to the buffer. If segments is not nullptr,
+// constant strings are referenced in place instead of being copied, and the message is described
+// by the list of segments (constant strings and buffer contents). Otherwise, the whole message is in the buffer.
+// Constant strings still take up their length in the buffer (without being written), so messages
+// are truncated the same way in both cases.
+struct log_output {
+    char* buff;
+    size_t buff_size;
+    size_t buff_pos = 0;
+    log_segment_t* segments = nullptr;
+    size_t num_segments = 0;
+    size_t max_segments = 0;
+};
+typedef struct log_output log_output_t;
+
+// Returns true if the last segment ends at the current buffer position.
+static inline bool output_in_buff(const log_output_t& out) {
+    if (out.num_segments == 0) {
+        return false;
+    }
+
+    const log_segment_t& last = out.segments[out.num_segments - 1];
+    return last.data >= out.buff && last.data < out.buff + out.buff_size && last.data + last.len == out.buff + out.buff_pos;
+}
+
+// Adds the buffer contents written since buff_start to the segment list.
+static inline void output_commit(log_output_t& out, const size_t buff_start) {
+    if (out.segments == nullptr || out.buff_pos == buff_start) {
+        return;
+    }
+
+    log_segment_t* last = (out.num_segments > 0) ? &out.segments[out.num_segments - 1] : nullptr;
+
+    if (last != nullptr && last->data >= out.buff && last->data < out.buff + out.buff_size && last->data + last->len == out.buff + buff_start) {
+        last->len += out.buff_pos - buff_start;
+    } else if (out.num_segments < out.max_segments) {
+        out.segments[out.num_segments++] = {out.buff + buff_start, out.buff_pos - buff_start};
+    }
+}
+
+// Appends a constant string. The last segment is kept for the buffer, so once the
+// segments run out, the rest of the message is copied into the buffer.
+static inline void output_const(log_output_t& out, const char* str, size_t len) {
+    if (out.segments != nullptr && out.num_segments + 1 < out.max_segments) {
+        if (out.buff_pos + 1 >= out.buff_size) {
+            return;
+        }
+
+        if (len > out.buff_size - out.buff_pos - 1) {
+            len = out.buff_size - out.buff_pos - 1;
+        }
+
+        if (len > 0) {
+            out.segments[out.num_segments++] = {str, len};
+            out.buff_pos += len;
+        }
+        return;
+    }
+
+    const size_t buff_start = out.buff_pos;
+    buff_append(out.buff, out.buff_size, out.buff_pos, str, len);
+    output_commit(out, buff_start);
+}
+
+// Appends a constant null-terminated string.
+static inline void output_concat(log_output_t& out, const char* str) {
+    if (out.buff_pos + 1 < out.buff_size) {
+        output_const(out, str, strnlen(str, out.buff_size - out.buff_pos - 1));
+    }
+}
+
+// Appends the decimal digits of value (zero-padded to min_digits).
+static inline void output_uint(log_output_t& out, const uint32_t value, const size_t min_digits) {
+    const size_t buff_start = out.buff_pos;
+    buff_write_uint(out.buff, out.buff_size, out.buff_pos, value, min_digits);
+    output_commit(out, buff_start);
+}
\ No newline at end of file
@@ -20,21 +20,34 @@
 */
 
 #pragma once
-
+#include "pico_log_lib/internal/macros.h"
+#include <stdint.h>
 
 // Logger verbosity levels.
 typedef enum {
-    LOG_LVL_DEBUG, 
-    LOG_LVL_INFO, 
-    LOG_LVL_WARN, 
-    LOG_LVL_ERROR, 
-    LOG_LVL_FATAL
+    LOG_LVL_DEBUG = PICO_LOG_LVL_DEBUG, 
+    LOG_LVL_INFO  = PICO_LOG_LVL_INFO, 
+    LOG_LVL_WARN  = PICO_LOG_LVL_WARN, 
+    LOG_LVL_ERROR = PICO_LOG_LVL_ERROR, 
+    LOG_LVL_FATAL = PICO_LOG_LVL_FATAL
 } LOG_LEVEL_t;
 
+// Handling of log messages while another core or task is writing to the sinks.
+typedef enum {
+    LOG_LOCK_QUEUE,   // Queued, and output by the current writer (truncated at LOGGER_RECORD_TEXT_SIZE - 1 characters, dropped if the record buffer is full).
+    LOG_LOCK_BLOCK,   // Wait until the sinks are free.
+    LOG_LOCK_TIMEOUT, // Wait for at most lock_timeout_us, then drop the message.
+    LOG_LOCK_TRY      // Dropped immediately.
+} LOG_LOCK_POLICY_t;
+
 // Logger options structure.
 typedef struct {
     LOG_LEVEL_t logging_level;
     const char* log_format;
     bool ansi_styling;
     bool process_style_tags;
+    bool deferred_logging;
+    LOG_LOCK_POLICY_t lock_policy;
+    uint32_t lock_timeout_us;
+    bool suppress_repeats;
 } logger_options_t;
\ No newline at end of file
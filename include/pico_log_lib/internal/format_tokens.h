@@ -0,0 +1,177 @@
+/*
+    Pico Log - Log format tokenizer.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "pico_log_lib/internal/style_tags.h"
+
+
+enum LOG_FORMAT_TOKEN_TYPE {
+    FORMAT_TOKEN_END,
+    FORMAT_TOKEN_TEXT,
+    FORMAT_TOKEN_FUNC,
+    FORMAT_TOKEN_FILE,
+    FORMAT_TOKEN_LINE,
+    FORMAT_TOKEN_TASK,
+    FORMAT_TOKEN_CORE,
+    FORMAT_TOKEN_LEVEL,
+    FORMAT_TOKEN_TIMESTAMP,
+    FORMAT_TOKEN_MSG,
+};
+
+// Log format pre-parser token structure.
+// Text tokens point to their pre-rendered characters in the tokenizer arena.
+struct log_format_token {
+    LOG_FORMAT_TOKEN_TYPE type = FORMAT_TOKEN_END;
+    const char* str_ptr = nullptr;
+    size_t txt_token_len = 0;
+};
+typedef struct log_format_token log_format_token_t;
+
+// Log format field tags (without the enclosing '%' symbols).
+struct log_format_field {
+    const char* name;
+    LOG_FORMAT_TOKEN_TYPE type;
+};
+
+constexpr log_format_field LOG_FORMAT_FIELDS[] = {
+    {"TSTMP", FORMAT_TOKEN_TIMESTAMP},
+    {"TASK",  FORMAT_TOKEN_TASK},
+    {"LVL",   FORMAT_TOKEN_LEVEL},
+    {"LINE",  FORMAT_TOKEN_LINE},
+    {"FILE",  FORMAT_TOKEN_FILE},
+    {"FUNC",  FORMAT_TOKEN_FUNC},
+    {"MSG",   FORMAT_TOKEN_MSG},
+    {"CORE",  FORMAT_TOKEN_CORE},
+};
+
+
+/*
+    Splits a log format string into tokens. Each run of text, style tags and color tags
+    between two fields is merged into a single text token, and rendered into arena
+    (with the tags replaced with their ANSI escape codes). Style and color tags are
+    only rendered if ansi_styling is true. Unknown tags are skipped.
+    Tokens past max_tokens and text past arena_size are discarded. Returns the number of tokens written.
+    Usable both at run-time and at compile-time.
+*/
+constexpr size_t log_format_tokenize(const char* src_ptr, log_format_token_t* tokens, const size_t max_tokens, const bool ansi_styling, 
+                                     char* arena, const size_t arena_size) {
+    size_t token_num = 0, arena_pos = 0;
+
+    // Appends to the current text token, starting a new one if needed.
+    auto append_text = [&](const char* str, const size_t len) {
+        if (tokens[token_num].type != FORMAT_TOKEN_TEXT) {
+            tokens[token_num].type = FORMAT_TOKEN_TEXT;
+            tokens[token_num].str_ptr = arena + arena_pos;
+            tokens[token_num].txt_token_len = 0;
+        }
+
+        for (size_t i = 0; i < len && arena_pos < arena_size; i++) {
+            arena[arena_pos++] = str[i];
+            tokens[token_num].txt_token_len++;
+        }
+    };
+
+    while (*src_ptr && token_num < max_tokens) {
+        if (*src_ptr != '%') {
+            append_text(src_ptr++, 1);
+            continue;
+        }
+
+        LOG_FORMAT_TOKEN_TYPE field_type = FORMAT_TOKEN_END;
+        size_t name_len = 0;
+
+        for (const log_format_field& field : LOG_FORMAT_FIELDS) {
+            name_len = style_tag_match(src_ptr + 1, field.name);
+            if (name_len > 0 && src_ptr[name_len + 1] == '%') {
+                field_type = field.type;
+                break;
+            }
+        }
+
+        if (field_type != FORMAT_TOKEN_END) {
+            // Terminate the current text token
+            if (tokens[token_num].type == FORMAT_TOKEN_TEXT && ++token_num >= max_tokens) {
+                break;
+            }
+
+            tokens[token_num++].type = field_type;
+            src_ptr += name_len + 2;
+            continue;
+        }
+
+        const style_tag_t tag = style_tag_parse(src_ptr);
+        if (tag.len == 0) {
+            // Not a valid tag, skip the '%' symbol.
+            src_ptr++;
+            continue;
+        }
+
+        if (ansi_styling && tag.style != nullptr) {
+            append_text(tag.style, style_strlen(tag.style));
+        } else if (ansi_styling) {
+            append_text(style_color_escape(tag.color_code).str, style_color_escape(tag.color_code).len);
+        }
+
+        src_ptr += tag.len;
+    }
+
+    if (token_num < max_tokens && tokens[token_num].type == FORMAT_TOKEN_TEXT) {
+        token_num++;
+    }
+
+    return token_num;
+}
+
+// Tokenizes a log format string, and returns its number of tokens
+// and rendered text characters in token_count and text_len (compile-time only).
+consteval void log_format_measure(const char* format, const bool ansi_styling, size_t& token_count, size_t& text_len) {
+    size_t format_len = 0;
+    while (format[format_len]) {
+        format_len++;
+    }
+
+    // Tags are at least 5 characters long, and rendered into at most 8 characters.
+    log_format_token_t* tokens = new log_format_token_t[format_len + 1];
+    char* arena = new char[format_len * 2 + 1];
+    token_count = log_format_tokenize(format, tokens, format_len + 1, ansi_styling, arena, format_len * 2 + 1);
+    text_len = 0;
+
+    for (size_t i = 0; i < token_count; i++) {
+        text_len += tokens[i].txt_token_len;
+    }
+
+    delete[] tokens;
+    delete[] arena;
+}
+
+// Returns the number of tokens in a log format string (compile-time only).
+consteval size_t log_format_token_count(const char* format, const bool ansi_styling) {
+    size_t token_count = 0, text_len = 0;
+    log_format_measure(format, ansi_styling, token_count, text_len);
+    return token_count;
+}
+
+// Returns the number of rendered text characters in a log format string (compile-time only).
+consteval size_t log_format_text_len(const char* format, const bool ansi_styling) {
+    size_t token_count = 0, text_len = 0;
+    log_format_measure(format, ansi_styling, token_count, text_len);
+    return text_len;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+    Pico Log - Logging macros.
+    A fast logging library for RP2xxx microcontrollers.
+    
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+ 
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+ 
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+ 
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+
+// Flags of the linker tables of PICO_LOG_TABLE_ENTRY(): read-only (kept in flash), except in position-independent
+// (host) builds, where the addresses in a table are relocated when the program is loaded.
+#if defined(__PIC__) || defined(__PIE__)
+    #define PICO_LOG_TABLE_FLAGS "aw"
+#else
+    #define PICO_LOG_TABLE_FLAGS "a"
+#endif
+
+/*
+    Adds the address of entry (a variable with static storage duration) to the linker table section:
+    an array of pointers, bounded by the __start_<section> and __stop_<section> symbols.
+    The entry is written by the assembler rather than with a section attribute on the variable itself.
+    GCC puts the static variables of inline functions (including methods defined in a class body) in
+    COMDAT sections, which causes a section type conflict with the other variables of the section in the same file,
+    and it ignores section attributes in templates. As the entry is emitted with each copy of the calling code,
+    entries of inline functions and templates can appear more than once, all pointing to the same variable.
+*/
+#define PICO_LOG_TABLE_ENTRY(section, entry)                                                                           \
+    __asm__ (".pushsection " section ", \"" PICO_LOG_TABLE_FLAGS "\"\n\t"                                              \
+             ".balign %c1\n\t"                                                                                         \
+             ".dc.a %c0\n\t"                                                                                           \
+             ".popsection" : : "i" (entry), "i" (sizeof(void*)))
+
+// Numeric log levels, usable in preprocessor conditions.
+#define PICO_LOG_LVL_DEBUG 0
+#define PICO_LOG_LVL_INFO  1
+#define PICO_LOG_LVL_WARN  2
+#define PICO_LOG_LVL_ERROR 3
+#define PICO_LOG_LVL_FATAL 4
+#define PICO_LOG_LVL_NONE  5
+
+// Minimum log level compiled into the binary.
+// Logging macro calls below this level are removed at compile-time,
+// along with their message strings and arguments.
+#ifndef PICO_LOG_COMPILE_LEVEL
+    #define PICO_LOG_COMPILE_LEVEL PICO_LOG_LVL_DEBUG
+#endif
+
+// Per-level call wrappers.
+// Each one expands to its argument if the level is compiled in, or to nothing otherwise.
+#if PICO_LOG_COMPILE_LEVEL <= PICO_LOG_LVL_DEBUG
+    #define PICO_LOG_IF_DEBUG(...) __VA_ARGS__
+#else
+    #define PICO_LOG_IF_DEBUG(...) ((void) 0)
+#endif
+
+#if PICO_LOG_COMPILE_LEVEL <= PICO_LOG_LVL_INFO
+    #define PICO_LOG_IF_INFO(...) __VA_ARGS__
+#else
+    #define PICO_LOG_IF_INFO(...) ((void) 0)
+#endif
+
+#if PICO_LOG_COMPILE_LEVEL <= PICO_LOG_LVL_WARN
+    #define PICO_LOG_IF_WARN(...) __VA_ARGS__
+#else
+    #define PICO_LOG_IF_WARN(...) ((void) 0)
+#endif
+
+#if PICO_LOG_COMPILE_LEVEL <= PICO_LOG_LVL_ERROR
+    #define PICO_LOG_IF_ERROR(...) __VA_ARGS__
+#else
+    #define PICO_LOG_IF_ERROR(...) ((void) 0)
+#endif
+
+#if PICO_LOG_COMPILE_LEVEL <= PICO_LOG_LVL_FATAL
+    #define PICO_LOG_IF_FATAL(...) __VA_ARGS__
+#else
+    #define PICO_LOG_IF_FATAL(...) ((void) 0)
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*
+    Pico Log - Per-module log levels.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+
+// Per-module log level table size (must be a power of two, 256 at most).
+// Module names are hashed into this table, so modules may share an entry if it is too small.
+#ifndef LOGGER_MODULE_TABLE_SIZE
+    #define LOGGER_MODULE_TABLE_SIZE 32
+#endif
+
+static_assert((LOGGER_MODULE_TABLE_SIZE & (LOGGER_MODULE_TABLE_SIZE - 1)) == 0, "LOGGER_MODULE_TABLE_SIZE must be a power of two");
+static_assert(LOGGER_MODULE_TABLE_SIZE <= 256, "LOGGER_MODULE_TABLE_SIZE must not exceed 256");
+
+
+/*
+    Returns the module table index of a module name. Only the part of the name
+    after the last '/' or '\' is used, so __FILE__ can be used as a module name
+    regardless of the build directory. Usable both at run-time and at compile-time.
+*/
+constexpr uint8_t log_module_id(const char* name) {
+    const char* base_ptr = name;
+    uint32_t hash = 2166136261u;
+
+    for (const char* src_ptr = name; *src_ptr; src_ptr++) {
+        if (*src_ptr == '/' || *src_ptr == '\\') {
+            base_ptr = src_ptr + 1;
+        }
+    }
+
+    // FNV-1a
+    for (; *base_ptr; base_ptr++) {
+        hash = (hash ^ (uint8_t) *base_ptr) * 16777619u;
+    }
+
+    return hash & (LOGGER_MODULE_TABLE_SIZE - 1);
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+/*
+    Pico Log - Style tag definitions.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+// ANSI escape code constants.
+constexpr const char* ANSI_RESET = "\033[0m";
+constexpr const char* ANSI_BOLD = "\033[1m";
+constexpr const char* ANSI_UNDERLINE = "\033[4m";
+constexpr const char* ANSI_STRIKETHROUGH = "\033[9m";
+constexpr const char* ANSI_ITALIC = "\033[3m";
+
+// Style tag names (without the enclosing '%' symbols) and their ANSI escape codes.
+constexpr const char* STYLE_TAG_STYLES[] = {"BOLD", "ITL", "UDRLN", "STKTHR", "RST"};
+constexpr const char* STYLE_TAG_STYLES_ANSI[] = {ANSI_BOLD, ANSI_ITALIC, ANSI_UNDERLINE, ANSI_STRIKETHROUGH, ANSI_RESET};
+
+// Color tag names, in ANSI color code order.
+constexpr const char* STYLE_TAG_COLORS[] = {"BLK", "RED", "GRN", "YLW", "BLU", "MGT", "CYN", "WHT"};
+constexpr size_t STYLE_TAG_NUM_COLORS = sizeof(STYLE_TAG_COLORS) / sizeof(STYLE_TAG_COLORS[0]);
+
+// First ANSI color code of each color variant: normal, background (_BG), bright (_HI), bright background.
+constexpr uint8_t STYLE_COLOR_BASES[] = {30, 40, 90, 100};
+
+// Handling of style tags in log messages.
+enum STYLE_TAG_MODE {
+    STYLE_TAGS_KEEP,      // Left as they are.
+    STYLE_TAGS_TRANSLATE, // Replaced with their ANSI escape codes.
+    STYLE_TAGS_REMOVE     // Removed.
+};
+
+// Parsed style tag.
+struct style_tag {
+    size_t len = 0;              // Tag length (including both '%' symbols), 0 if not a valid tag.
+    const char* style = nullptr; // ANSI escape code of style tags, nullptr for color tags.
+    uint8_t color_code = 0;      // ANSI color code of color tags.
+};
+typedef struct style_tag style_tag_t;
+
+
+// Returns the length of the name at the start of str_ptr, or 0 if str_ptr does not start with it.
+constexpr size_t style_tag_match(const char* str_ptr, const char* name) {
+    size_t len = 0;
+
+    for (; name[len]; len++) {
+        if (str_ptr[len] != name[len]) {
+            return 0;
+        }
+    }
+
+    return len;
+}
+
+// Parses the style tag at the start of str_ptr (pointing to the opening '%' symbol).
+constexpr style_tag_t style_tag_parse(const char* str_ptr) {
+    style_tag_t tag;
+
+    if (*str_ptr != '%') {
+        return tag;
+    }
+
+    for (size_t i = 0; i < sizeof(STYLE_TAG_STYLES) / sizeof(STYLE_TAG_STYLES[0]); i++) {
+        const size_t name_len = style_tag_match(str_ptr + 1, STYLE_TAG_STYLES[i]);
+        if (name_len > 0 && str_ptr[name_len + 1] == '%') {
+            tag.len = name_len + 2;
+            tag.style = STYLE_TAG_STYLES_ANSI[i];
+            return tag;
+        }
+    }
+
+    for (uint8_t i = 0; i < sizeof(STYLE_TAG_COLORS) / sizeof(STYLE_TAG_COLORS[0]); i++) {
+        size_t tag_len = style_tag_match(str_ptr + 1, STYLE_TAG_COLORS[i]);
+        if (tag_len == 0) {
+            continue;
+        }
+
+        // Color suffixes (_HI, _BG), each can be used once.
+        bool bright = false, background = false;
+        tag.color_code = 30 + i;
+        tag_len++;
+
+        while (str_ptr[tag_len] == '_') {
+            if (!bright && style_tag_match(str_ptr + tag_len + 1, "HI")) {
+                tag.color_code += 60;
+                bright = true;
+            } else if (!background && style_tag_match(str_ptr + tag_len + 1, "BG")) {
+                tag.color_code += 10;
+                background = true;
+            } else {
+                break;
+            }
+
+            tag_len += 3;
+        }
+
+        tag.len = (str_ptr[tag_len] == '%') ? tag_len + 1 : 0;
+        return tag;
+    }
+
+    return tag;
+}
+
+// Returns the length of the style tag (including both '%' symbols) at the start of str_ptr,
+// or 0 if str_ptr does not start with a valid style tag.
+constexpr size_t style_tag_len(const char* str_ptr) {
+    return style_tag_parse(str_ptr).len;
+}
+
+// Returns the length of a null-terminated string.
+constexpr size_t style_strlen(const char* str) {
+    size_t len = 0;
+
+    while (str[len]) {
+        len++;
+    }
+
+    return len;
+}
+
+// Writes the ANSI escape code of a color code ("\033[0;XXm" or "\033[0;XXXm") to buff.
+// buff must have space for 8 characters. Returns the length of the escape code.
+constexpr size_t style_color_ansi(const uint8_t color_code, char* buff) {
+    size_t len = 0;
+
+    buff[len++] = '\033';
+    buff[len++] = '[';
+    buff[len++] = '0';
+    buff[len++] = ';';
+
+    if (color_code >= 100) {
+        buff[len++] = '0' + color_code / 100;
+    }
+
+    buff[len++] = '0' + (color_code / 10) % 10;
+    buff[len++] = '0' + color_code % 10;
+    buff[len++] = 'm';
+    return len;
+}
+
+// Pre-rendered ANSI escape code.
+struct style_escape {
+    char str[8] = {};
+    uint8_t len = 0;
+};
+typedef struct style_escape style_escape_t;
+
+// Returns the index of a color code in STYLE_COLOR_ESCAPES.
+constexpr size_t style_color_index(const uint8_t color_code) {
+    for (size_t i = 0; i < sizeof(STYLE_COLOR_BASES); i++) {
+        if (color_code >= STYLE_COLOR_BASES[i] && color_code < STYLE_COLOR_BASES[i] + STYLE_TAG_NUM_COLORS) {
+            return i * STYLE_TAG_NUM_COLORS + color_code - STYLE_COLOR_BASES[i];
+        }
+    }
+
+    return 0;
+}
+
+// ANSI escape codes of all color tags, rendered at compile-time.
+constexpr auto STYLE_COLOR_ESCAPES = [] {
+    std::array<style_escape_t, sizeof(STYLE_COLOR_BASES) * STYLE_TAG_NUM_COLORS> escapes = {};
+
+    for (size_t i = 0; i < escapes.size(); i++) {
+        const uint8_t color_code = STYLE_COLOR_BASES[i / STYLE_TAG_NUM_COLORS] + i % STYLE_TAG_NUM_COLORS;
+        escapes[i].len = style_color_ansi(color_code, escapes[i].str);
+    }
+
+    return escapes;
+}();
+
+// Returns the pre-rendered ANSI escape code of a color code.
+constexpr const style_escape_t& style_color_escape(const uint8_t color_code) {
+    return STYLE_COLOR_ESCAPES[style_color_index(color_code)];
+}
+
+
+/*
+    Replaces the style tags in a message with their ANSI escape codes,
+    or removes them if styled is false. Escaped '%' symbols ("%%") are left as they are.
+    At most buff_size - 1 characters are written, buff is always null-terminated.
+    If buff is nullptr, only the length is computed. Returns the length of the translated message.
+    Usable both at run-time and at compile-time.
+*/
+constexpr size_t style_translate(const char* src_ptr, char* buff, const size_t buff_size, const bool styled) {
+    size_t buff_pos = 0;
+
+    // Characters that don't fit are still counted, but not written.
+    auto put_chars = [&](const char* str, const size_t len) {
+        for (size_t i = 0; i < len; i++, buff_pos++) {
+            if (buff != nullptr && buff_pos + 1 < buff_size) {
+                buff[buff_pos] = str[i];
+            }
+        }
+    };
+
+    while (*src_ptr) {
+        if (*src_ptr != '%') {
+            put_chars(src_ptr++, 1);
+            continue;
+        }
+
+        if (src_ptr[1] == '%') {
+            put_chars(src_ptr, 2);
+            src_ptr += 2;
+            continue;
+        }
+
+        const style_tag_t tag = style_tag_parse(src_ptr);
+        if (tag.len == 0) {
+            put_chars(src_ptr++, 1);
+            continue;
+        }
+
+        if (styled && tag.style != nullptr) {
+            put_chars(tag.style, style_strlen(tag.style));
+        } else if (styled) {
+            put_chars(style_color_escape(tag.color_code).str, style_color_escape(tag.color_code).len);
+        }
+
+        src_ptr += tag.len;
+    }
+
+    if (buff != nullptr && buff_size > 0) {
+        buff[(buff_pos < buff_size) ? buff_pos : buff_size - 1] = '\0';
+    }
+
+    return buff_pos;
+}
\ No newline at end of file
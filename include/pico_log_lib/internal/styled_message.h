@@ -0,0 +1,65 @@
+/*
+    Pico Log - Compile-time styled log messages.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "pico_log_lib/internal/style_tags.h"
+#include <array>
+
+
+// Log message with style tags translated at compile-time.
+struct styled_message {
+    const char* styled; // Style tags replaced with ANSI escape codes.
+    const char* plain;  // Style tags removed.
+};
+typedef struct styled_message styled_message_t;
+
+// String literal wrapper, usable as a template argument.
+template <size_t N>
+struct style_literal {
+    char str[N];
+
+    consteval style_literal(const char (&literal)[N]) {
+        for (size_t i = 0; i < N; i++) {
+            this->str[i] = literal[i];
+        }
+    }
+};
+
+// Translates the style tags of a string literal into a null-terminated array.
+template <style_literal literal, bool styled>
+consteval auto style_translate_literal() {
+    std::array<char, style_translate(literal.str, nullptr, 0, styled) + 1> buff = {};
+    (void) style_translate(literal.str, buff.data(), buff.size(), styled);
+    return buff;
+}
+
+// Storage for the translated variants of a message literal.
+template <style_literal literal>
+struct styled_literal {
+    static constexpr auto styled = style_translate_literal<literal, true>();
+    static constexpr auto plain = style_translate_literal<literal, false>();
+    static constexpr styled_message_t message = {styled.data(), plain.data()};
+};
+
+
+// Translates the style tags of a log message literal at compile-time.
+// The result can be passed to Logger::log() and Logger::vlog() in place of the message.
+#define PICO_LOG_STYLED(msg) (styled_literal<msg>::message)
\ No newline at end of file
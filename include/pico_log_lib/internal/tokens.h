@@ -0,0 +1,149 @@
+/*
+    Pico Log - Tokenized binary log records.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+#include "pico_log_lib/internal/macros.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+
+// Number of tokenized records between two absolute timestamps (the others carry the delta to the previous one).
+#ifndef LOGGER_TOKEN_SYNC_INTERVAL
+    #define LOGGER_TOKEN_SYNC_INTERVAL 64
+#endif
+
+// Tokenized log call site. Descriptors are constant, and listed in the pico_log_tokens table,
+// where the host decoder (tools/pico_log_decode.py) looks up the message and call site of each record.
+struct log_token {
+    uint32_t id;
+    const char* format;
+    const char* func;
+    const char* file;
+    uint16_t line;
+    uint8_t level;
+};
+typedef struct log_token log_token_t;
+
+// Token ID of text records (messages that were formatted on the device).
+constexpr uint32_t LOG_TOKEN_TEXT = 0;
+
+// Returns the token ID of a call site: the FNV-1a hash of its message, file and line.
+// IDs don't depend on addresses, so they stay the same across builds as long as the call site doesn't change.
+constexpr uint32_t log_token_id(const char* format, const char* file, const uint32_t line) {
+    uint32_t hash = 2166136261u;
+
+    for (const char* str : {format, file}) {
+        for (; *str; str++) {
+            hash = (hash ^ (uint8_t) *str) * 16777619u;
+        }
+
+        hash = (hash ^ 0) * 16777619u;
+    }
+
+    for (uint32_t i = 0; i < 4; i++) {
+        hash = (hash ^ ((line >> (i * 8)) & 0xFF)) * 16777619u;
+    }
+
+    return (hash == LOG_TOKEN_TEXT) ? 1 : hash;
+}
+
+
+/*
+    Registers a tokenized log call site in the pico_log_tokens table, and evaluates call.
+    call can reference the token descriptor as pico_log_token.
+    The token ID is computed at compile-time.
+*/
+#define PICO_LOG_TOKEN(lvl, msg, call)                                                                                 \
+    __extension__ ({                                                                                                   \
+        static const log_token_t pico_log_token =                                                                      \
+            {std::integral_constant<uint32_t, log_token_id(msg, __FILE__, __LINE__)>::value,                           \
+             msg, __func__, __FILE__, __LINE__, (uint8_t) (lvl)};                                                      \
+        PICO_LOG_TABLE_ENTRY("pico_log_tokens", &pico_log_token);                                                      \
+        call;                                                                                                          \
+    })
+
+
+/*
+    Wire format. Each record is sent as a frame: its payload, COBS-encoded (so it contains no zero bytes),
+    followed by a zero byte. Payloads start with the token ID (4 bytes, little-endian).
+    - Tokenized records: token ID, timestamp (varint), captured arguments (see log_args_capture()).
+      The timestamp is (ms << 1) | 1 for absolute timestamps, or zigzag(delta_ms) << 1
+      for the delta to the previous tokenized record.
+    - Text records: LOG_TOKEN_TEXT, then the formatted message.
+*/
+
+// Maximum length of the timestamp varint.
+constexpr size_t LOG_WIRE_VARINT_MAX_LEN = 10;
+
+// Returns the maximum COBS-encoded frame length (including the zero byte) of a payload.
+constexpr size_t log_wire_frame_len(const size_t payload_len) {
+    return payload_len + payload_len / 254 + 2;
+}
+
+// Writes value as a varint (7 bits per byte, least significant first) to dst. Returns the number of bytes written.
+static inline size_t log_wire_varint(uint64_t value, uint8_t* dst) {
+    size_t len = 0;
+
+    while (value >= 0x80) {
+        dst[len++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+
+    dst[len++] = (uint8_t) value;
+    return len;
+}
+
+// Returns the timestamp field of a tokenized record.
+static inline uint64_t log_wire_timestamp(const uint32_t timestamp_ms, const uint32_t last_ms, const bool absolute) {
+    if (absolute) {
+        return ((uint64_t) timestamp_ms << 1) | 1;
+    }
+
+    const int32_t delta = (int32_t) (timestamp_ms - last_ms);
+    return (uint64_t) (((uint32_t) delta << 1) ^ (uint32_t) (delta >> 31)) << 1;
+}
+
+// COBS-encodes len bytes of src into dst, which must have space for len + len / 254 + 1 bytes.
+// Returns the encoded length (without the terminating zero byte).
+static inline size_t log_wire_cobs(const uint8_t* src, const size_t len, uint8_t* dst) {
+    size_t code_pos = 0, dst_pos = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] != 0) {
+            dst[dst_pos++] = src[i];
+            code++;
+        }
+
+        if (src[i] == 0 || code == 0xFF) {
+            dst[code_pos] = code;
+            code_pos = dst_pos++;
+            code = 1;
+        }
+    }
+
+    dst[code_pos] = code;
+    return dst_pos;
+}
\ No newline at end of file
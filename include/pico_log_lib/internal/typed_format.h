@@ -0,0 +1,170 @@
+/*
+    Pico Log - Type-safe message formatter.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "pico_log_lib/internal/style_tags.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+// Default number of decimal places of float and double arguments.
+#ifndef LOG_TYPED_FLOAT_DIGITS
+    #define LOG_TYPED_FLOAT_DIGITS 3
+#endif
+
+enum LOG_TYPED_ARG_TYPE : uint8_t {
+    TYPED_ARG_NONE,
+    TYPED_ARG_BOOL,
+    TYPED_ARG_CHAR,
+    TYPED_ARG_INT,
+    TYPED_ARG_UINT,
+    TYPED_ARG_INT64,
+    TYPED_ARG_UINT64,
+    TYPED_ARG_HEX,
+    TYPED_ARG_FLOAT,
+    TYPED_ARG_DOUBLE,
+    TYPED_ARG_FIXED,
+    TYPED_ARG_STR,
+    TYPED_ARG_PTR
+};
+
+// Type-erased log_typed() argument.
+struct log_typed_arg {
+    LOG_TYPED_ARG_TYPE type = TYPED_ARG_NONE;
+    uint8_t digits = 0;    // Minimum number of hex digits, or number of decimal places.
+    uint8_t frac_bits = 0; // Fractional bits of fixed-point values.
+    union {
+        int32_t i32;
+        uint32_t u32;
+        int64_t i64;
+        uint64_t u64 = 0;
+        float f32;
+        double f64;
+        const char* str;
+        const void* ptr;
+    };
+};
+typedef struct log_typed_arg log_typed_arg_t;
+
+
+// Formats an unsigned integer as hex (without a "0x" prefix), zero-padded to min_digits.
+inline log_typed_arg_t log_hex(const uint64_t value, const uint8_t min_digits = 1) {
+    log_typed_arg_t arg;
+    arg.type = TYPED_ARG_HEX;
+    arg.digits = min_digits;
+    arg.u64 = value;
+    return arg;
+}
+
+// Formats a float or double with the given number of decimal places (max. 9).
+inline log_typed_arg_t log_float(const double value, const uint8_t decimals) {
+    log_typed_arg_t arg;
+    arg.type = TYPED_ARG_DOUBLE;
+    arg.digits = decimals;
+    arg.f64 = value;
+    return arg;
+}
+
+// Formats a signed fixed-point value (raw / 2^frac_bits) with the given number
+// of decimal places (max. 9), without using floating-point arithmetic.
+inline log_typed_arg_t log_fixed(const int32_t raw, const uint8_t frac_bits, const uint8_t decimals = LOG_TYPED_FLOAT_DIGITS) {
+    log_typed_arg_t arg;
+    arg.type = TYPED_ARG_FIXED;
+    arg.digits = decimals;
+    arg.frac_bits = frac_bits;
+    arg.i32 = raw;
+    return arg;
+}
+
+
+template <typename T>
+constexpr bool log_typed_unsupported = false;
+
+// Converts a log_typed() argument to a type-erased argument.
+// The conversion is picked at compile-time, unsupported types are rejected.
+template <typename T>
+inline log_typed_arg_t log_typed_arg(const T& value) {
+    using type = std::remove_cv_t<T>;
+    log_typed_arg_t arg;
+
+    if constexpr (std::is_same_v<type, log_typed_arg_t>) {
+        return value;
+    } else if constexpr (std::is_same_v<type, bool>) {
+        arg.type = TYPED_ARG_BOOL;
+        arg.u32 = value;
+    } else if constexpr (std::is_same_v<type, char>) {
+        arg.type = TYPED_ARG_CHAR;
+        arg.u32 = value;
+    } else if constexpr (std::is_enum_v<type>) {
+        return log_typed_arg(static_cast<std::underlying_type_t<type>>(value));
+    } else if constexpr (std::is_integral_v<type> && std::is_signed_v<type>) {
+        if constexpr (sizeof(type) <= sizeof(int32_t)) {
+            arg.type = TYPED_ARG_INT;
+            arg.i32 = value;
+        } else {
+            arg.type = TYPED_ARG_INT64;
+            arg.i64 = value;
+        }
+    } else if constexpr (std::is_integral_v<type>) {
+        if constexpr (sizeof(type) <= sizeof(uint32_t)) {
+            arg.type = TYPED_ARG_UINT;
+            arg.u32 = value;
+        } else {
+            arg.type = TYPED_ARG_UINT64;
+            arg.u64 = value;
+        }
+    } else if constexpr (std::is_same_v<type, float>) {
+        arg.type = TYPED_ARG_FLOAT;
+        arg.digits = LOG_TYPED_FLOAT_DIGITS;
+        arg.f32 = value;
+    } else if constexpr (std::is_floating_point_v<type>) {
+        arg.type = TYPED_ARG_DOUBLE;
+        arg.digits = LOG_TYPED_FLOAT_DIGITS;
+        arg.f64 = value;
+    } else if constexpr (std::is_same_v<type, std::nullptr_t>) {
+        arg.type = TYPED_ARG_STR;
+        arg.str = nullptr;
+    } else if constexpr (std::is_array_v<type> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<type>>, char>) {
+        arg.type = TYPED_ARG_STR;
+        arg.str = value;
+    } else if constexpr (std::is_pointer_v<type> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<type>>, char>) {
+        arg.type = TYPED_ARG_STR;
+        arg.str = value;
+    } else if constexpr (std::is_pointer_v<type>) {
+        arg.type = TYPED_ARG_PTR;
+        arg.ptr = value;
+    } else {
+        static_assert(log_typed_unsupported<T>, "Unsupported log_typed() argument type");
+    }
+
+    return arg;
+}
+
+
+/*
+    Formats a message with "{}" placeholders, which are replaced with the arguments in order.
+    "{{" and "}}" are written as '{' and '}', "%%" is written as '%'. Placeholders without
+    an argument are left as they are. Style tags are handled according to style_tags.
+    The output is always null-terminated. Returns the number of characters written.
+*/
+size_t log_typed_format(char* buff, const size_t buff_size, const char* format, 
+                        const log_typed_arg_t* args, const size_t num_args, const STYLE_TAG_MODE style_tags);
\ No newline at end of file
@@ -23,23 +23,40 @@
 #include "pico/stdlib.h"
 #include "pico/stdio/driver.h"
 #include "pico_log_lib/internal/common.h"
+#include "pico_log_lib/internal/arg_capture.h"
+#include "pico_log_lib/internal/format_tokens.h"
+#include "pico_log_lib/internal/styled_message.h"
+#include "pico_log_lib/internal/typed_format.h"
+#include "pico_log_lib/internal/modules.h"
+#include "pico_log_lib/internal/tokens.h"
+#include "pico_log_lib/callsites.h"
+#include "pico_log_lib/ratelimit.h"
+#include "pico_log_lib/sink.h"
+#include "hardware/sync.h"
+#include <atomic>
+#include <type_traits>
+#include <utility>
 
 #ifdef PICO_LOG_FREERTOS
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
 #else
 #include "pico/sync.h"
 #endif
 
 
 // Main logger buffer size.
-// Note that two buffers of this size are created.
 // This value is NOT the maximum length of the log message,
 // but the maximum length of the log message after formatting and styling are applied.
 #ifndef LOGGER_BUFF_SIZE
     #define LOGGER_BUFF_SIZE 256
 #endif
 
+// Compile-time log format string (PICO_LOG_STATIC_FORMAT, not defined by default).
+// If defined, the log format is parsed at compile-time and options->log_format is ignored.
+// Set it with the PICO_LOG_STATIC_FORMAT CMake option, e.g. -DPICO_LOG_STATIC_FORMAT="[%LVL%] %MSG%".
+
 // Maximum number of tokens in the log format string.
 // This value is used to limit the number of tokens that can be processed in the log format string.
 // The actual number of tokens in the log format string may be less than this value.
@@ -47,13 +64,127 @@
     #define LOG_FORMAT_MAX_TOKENS 16
 #endif
 
-// ANSI escape code constants.
-constexpr const char* ANSI_RESET = "\033[0m";
-constexpr const char* ANSI_BOLD = "\033[1m";
-constexpr const char* ANSI_UNDERLINE = "\033[4m";
-constexpr const char* ANSI_STRIKETHROUGH = "\033[9m";
-constexpr const char* ANSI_ITALIC = "\033[3m";
+// Size of the buffer holding the pre-rendered text parts of the log format.
+// Adjacent text, style tags and color tags are rendered into a single token stored here.
+#ifndef LOG_FORMAT_ARENA_SIZE
+    #define LOG_FORMAT_ARENA_SIZE 128
+#endif
+
+// Maximum number of segments a message is split into for sinks with out_segments.
+// The rest of a message that needs more segments is copied into the main buffer.
+#ifndef LOGGER_MAX_SEGMENTS
+    #define LOGGER_MAX_SEGMENTS 24
+#endif
 
+// Maximum number of output sinks of a logger (including the one passed to the constructor).
+#ifndef LOGGER_MAX_SINKS
+    #define LOGGER_MAX_SINKS 4
+#endif
+
+// Deferred log record buffer size (must be a power of two).
+// Records queued in deferred logging mode are stored here until drain() is called.
+#ifndef LOGGER_RECORD_BUFF_SIZE
+    #define LOGGER_RECORD_BUFF_SIZE 1024
+#endif
+
+// Maximum size of the captured arguments of a single deferred log record.
+// Arguments that do not fit are dropped from the formatted message.
+#ifndef LOGGER_RECORD_ARGS_SIZE
+    #define LOGGER_RECORD_ARGS_SIZE 64
+#endif
+
+// Maximum length of a message queued as text: log_typed() messages in deferred logging mode,
+// and messages queued while another core or task holds the log mutex (LOG_LOCK_QUEUE).
+// These messages are formatted by the caller (on its stack), longer messages are truncated and end with "[...]".
+#ifndef LOGGER_RECORD_TEXT_SIZE
+    #define LOGGER_RECORD_TEXT_SIZE LOGGER_BUFF_SIZE
+#endif
+
+// Interval (in milliseconds) at which the repeats of a message are logged while it keeps repeating,
+// with suppress_repeats. Repeats counted for longer are also logged by drain() and the next log call.
+#ifndef LOGGER_REPEAT_FLUSH_MS
+    #define LOGGER_REPEAT_FLUSH_MS 1000
+#endif
+
+#ifdef PICO_LOG_FREERTOS
+// Default priority of the background log task.
+#ifndef LOGGER_TASK_PRIORITY
+    #define LOGGER_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+#endif
+
+// Default stack depth (in words) of the background log task.
+#ifndef LOGGER_TASK_STACK_SIZE
+    #define LOGGER_TASK_STACK_SIZE 1024
+#endif
+#endif
+
+
+// Module name used by the logging macros for per-module log levels.
+// Define it before including this header to group several files into one module.
+#ifndef PICO_LOG_MODULE
+    #define PICO_LOG_MODULE __FILE__
+#endif
+
+// Module table index of PICO_LOG_MODULE, computed at compile-time.
+#define PICO_LOG_MODULE_ID (std::integral_constant<uint8_t, log_module_id(PICO_LOG_MODULE)>::value)
+
+// Log call with the current module (and call site, if PICO_LOG_CALLSITES is defined).
+// With PICO_LOG_TOKENIZED, the call is tokenized instead (see internal/tokens.h).
+#if defined(PICO_LOG_TOKENIZED)
+    #define PICO_LOG_CALL(logger, lvl, msg, ...) \
+        PICO_LOG_TOKEN(lvl, msg, (logger).log_token(PICO_LOG_MODULE_ID, &pico_log_token __VA_OPT__(,) __VA_ARGS__))
+#elif defined(PICO_LOG_CALLSITES)
+    #define PICO_LOG_CALL(logger, lvl, msg, ...) \
+        PICO_LOG_CALLSITE(lvl, (logger).log_site(&pico_log_site, PICO_LOG_MODULE_ID, PICO_LOG_STYLED(msg) __VA_OPT__(,) __VA_ARGS__))
+#else
+    #define PICO_LOG_CALL(logger, lvl, msg, ...) \
+        (logger).log_module(PICO_LOG_MODULE_ID, __func__, __FILE__, __LINE__, lvl, PICO_LOG_STYLED(msg) __VA_OPT__(,) __VA_ARGS__)
+#endif
+
+// Logging macros. Calls below PICO_LOG_COMPILE_LEVEL are removed at compile-time.
+// The message must be a string literal, its style tags are translated at compile-time.
+#define PICO_LOG_DEBUG(logger, msg, ...) PICO_LOG_IF_DEBUG(PICO_LOG_CALL(logger, LOG_LVL_DEBUG, msg __VA_OPT__(,) __VA_ARGS__))
+#define PICO_LOG_INFO(logger, msg, ...)  PICO_LOG_IF_INFO(PICO_LOG_CALL(logger, LOG_LVL_INFO, msg __VA_OPT__(,) __VA_ARGS__))
+#define PICO_LOG_WARN(logger, msg, ...)  PICO_LOG_IF_WARN(PICO_LOG_CALL(logger, LOG_LVL_WARN, msg __VA_OPT__(,) __VA_ARGS__))
+#define PICO_LOG_ERROR(logger, msg, ...) PICO_LOG_IF_ERROR(PICO_LOG_CALL(logger, LOG_LVL_ERROR, msg __VA_OPT__(,) __VA_ARGS__))
+#define PICO_LOG_FATAL(logger, msg, ...) PICO_LOG_IF_FATAL(PICO_LOG_CALL(logger, LOG_LVL_FATAL, msg __VA_OPT__(,) __VA_ARGS__))
+
+// Logs at the given level (DEBUG, INFO, WARN, ERROR or FATAL), e.g. PICO_LOG(logger, INFO, "Hello").
+#define PICO_LOG(logger, lvl, ...) PICO_LOG_##lvl(logger, __VA_ARGS__)
+
+// Rate-limited logging at the given level (see ratelimit.h). Suppressed calls return before the logger is called.
+// e.g. PICO_LOG_EVERY_N(logger, WARN, 100, "Sensor fault: %d", code), PICO_LOG_RATE(logger, WARN, 2, 5, "Overrun").
+#define PICO_LOG_ONCE(logger, lvl, ...)              PICO_LOG_IF_##lvl(PICO_LOG_LIMIT_ONCE(PICO_LOG_CALL(logger, LOG_LVL_##lvl, __VA_ARGS__)))
+#define PICO_LOG_EVERY_N(logger, lvl, n, ...)        PICO_LOG_IF_##lvl(PICO_LOG_LIMIT_EVERY_N(n, PICO_LOG_CALL(logger, LOG_LVL_##lvl, __VA_ARGS__)))
+#define PICO_LOG_RATE(logger, lvl, rate, burst, ...) PICO_LOG_IF_##lvl(PICO_LOG_LIMIT_RATE(rate, burst, PICO_LOG_CALL(logger, LOG_LVL_##lvl, __VA_ARGS__)))
+
+// Logs from an interrupt handler at the given level, e.g. PICO_LOG_ISR(logger, WARN, "Overrun: %u", count).
+#define PICO_LOG_ISR(logger, lvl, msg, ...) \
+    PICO_LOG_IF_##lvl((logger).log_from_isr(__func__, __FILE__, __LINE__, LOG_LVL_##lvl, PICO_LOG_STYLED(msg) __VA_OPT__(,) __VA_ARGS__))
+
+// Type-safe log call (Logger::log_typed()) with the current module (and call site, if PICO_LOG_CALLSITES is defined).
+#ifdef PICO_LOG_CALLSITES
+    #define PICO_LOG_TYPED_CALL(logger, lvl, msg, ...) \
+        PICO_LOG_CALLSITE(lvl, (logger).log_typed_site(&pico_log_site, PICO_LOG_MODULE_ID, PICO_LOG_STYLED(msg) __VA_OPT__(,) __VA_ARGS__))
+#else
+    #define PICO_LOG_TYPED_CALL(logger, lvl, msg, ...) \
+        (logger).log_typed_module(PICO_LOG_MODULE_ID, __func__, __FILE__, __LINE__, lvl, PICO_LOG_STYLED(msg) __VA_OPT__(,) __VA_ARGS__)
+#endif
+
+// Type-safe logging macros, arguments replace the "{}" placeholders of the message.
+#define PICO_LOG_TYPED_DEBUG(logger, msg, ...) PICO_LOG_IF_DEBUG(PICO_LOG_TYPED_CALL(logger, LOG_LVL_DEBUG, msg __VA_OPT__(,) __VA_ARGS__))
+#define PICO_LOG_TYPED_INFO(logger, msg, ...)  PICO_LOG_IF_INFO(PICO_LOG_TYPED_CALL(logger, LOG_LVL_INFO, msg __VA_OPT__(,) __VA_ARGS__))
+#define PICO_LOG_TYPED_WARN(logger, msg, ...)  PICO_LOG_IF_WARN(PICO_LOG_TYPED_CALL(logger, LOG_LVL_WARN, msg __VA_OPT__(,) __VA_ARGS__))
+#define PICO_LOG_TYPED_ERROR(logger, msg, ...) PICO_LOG_IF_ERROR(PICO_LOG_TYPED_CALL(logger, LOG_LVL_ERROR, msg __VA_OPT__(,) __VA_ARGS__))
+#define PICO_LOG_TYPED_FATAL(logger, msg, ...) PICO_LOG_IF_FATAL(PICO_LOG_TYPED_CALL(logger, LOG_LVL_FATAL, msg __VA_OPT__(,) __VA_ARGS__))
+
+// Type-safe log call at the given level, e.g. PICO_LOG_TYPED(logger, INFO, "x = {}", x).
+#define PICO_LOG_TYPED(logger, lvl, ...) PICO_LOG_TYPED_##lvl(logger, __VA_ARGS__)
+
+
+// Formatted message output state (see internal/buff_write.h).
+struct log_output;
+typedef struct log_output log_output_t;
 
 /*
     Main logger class.
@@ -61,17 +192,172 @@ constexpr const char* ANSI_ITALIC = "\033[3m";
 class Logger {
     public:
         Logger(stdio_driver_t* stdio_driver, logger_options_t* options);
+        Logger(const log_sink_t& sink, logger_options_t* options);
         ~Logger();
 
         bool init_mutex();
+        bool add_sink(const log_sink_t& sink, const LOG_LEVEL_t level, const bool ansi_styling);
         void log(const char* func, const char* file, const uint16_t line, 
                  const LOG_LEVEL_t level, const char* message, ...);
         void vlog(const LOG_LEVEL_t level, const char* message, va_list args, 
                   const char* func, const char* file, const uint16_t line);
+        void log(const char* func, const char* file, const uint16_t line, 
+                 const LOG_LEVEL_t level, const styled_message_t message, ...);
+        void vlog(const LOG_LEVEL_t level, const styled_message_t message, va_list args, 
+                  const char* func, const char* file, const uint16_t line);
+        void log_module(const uint8_t module, const char* func, const char* file, const uint16_t line, 
+                        const LOG_LEVEL_t level, const char* message, ...);
+        void log_module(const uint8_t module, const char* func, const char* file, const uint16_t line, 
+                        const LOG_LEVEL_t level, const styled_message_t message, ...);
+        void vlog_module(const uint8_t module, const LOG_LEVEL_t level, const char* message, va_list args, 
+                         const char* func, const char* file, const uint16_t line);
+        void log_site(const log_callsite_t* site, const uint8_t module, const char* message, ...);
+        void log_site(const log_callsite_t* site, const uint8_t module, const styled_message_t message, ...);
+        void vlog_site(const log_callsite_t* site, const char* message, va_list args);
+
+        #ifdef PICO_LOG_TOKENIZED
+        // Tokenized alternative of log_module(). The arguments are captured and sent in binary form
+        // with the token ID, the message is formatted on the host (tools/pico_log_decode.py).
+        void log_token(const uint8_t module, const log_token_t* token, ...);
+        #endif
+
+        // Interrupt-safe alternatives of log(). The message is queued in the deferred record buffer
+        // in bounded time, without taking the log mutex, and is formatted and output later from thread context.
+        void log_from_isr(const char* func, const char* file, const uint16_t line, 
+                          const LOG_LEVEL_t level, const char* message, ...);
+        void vlog_from_isr(const LOG_LEVEL_t level, const char* message, va_list args, 
+                           const char* func, const char* file, const uint16_t line);
+        void log_from_isr(const char* func, const char* file, const uint16_t line, 
+                          const LOG_LEVEL_t level, const styled_message_t message, ...);
+
+        // Type-safe alternatives of log(), log_module() and log_site(), without printf.
+        // Arguments replace the "{}" placeholders of the message, formatted according to their types.
+        template <typename... Args>
+        inline void log_typed(const char* func, const char* file, const uint16_t line, 
+                              const LOG_LEVEL_t level, const char* message, const Args&... args) {
+            if (this->is_enabled(level)) {
+                const log_typed_arg_t typed_args[] = {log_typed_arg(args)..., {}};
+                this->vlog_typed(level, message, nullptr, typed_args, sizeof...(Args), func, file, line, this->style_tags_enabled());
+            }
+        }
+
+        template <typename... Args>
+        inline void log_typed(const char* func, const char* file, const uint16_t line, 
+                              const LOG_LEVEL_t level, const styled_message_t message, const Args&... args) {
+            if (this->is_enabled(level)) {
+                const log_typed_arg_t typed_args[] = {log_typed_arg(args)..., {}};
+                this->vlog_typed(level, this->style_tags_enabled() ? message.styled : message.plain, message.plain, 
+                                 typed_args, sizeof...(Args), func, file, line, false);
+            }
+        }
+
+        template <typename... Args>
+        inline void log_typed_module(const uint8_t module, const char* func, const char* file, const uint16_t line, 
+                                     const LOG_LEVEL_t level, const char* message, const Args&... args) {
+            if (this->is_enabled(level, module)) {
+                const log_typed_arg_t typed_args[] = {log_typed_arg(args)..., {}};
+                this->vlog_typed(level, message, nullptr, typed_args, sizeof...(Args), func, file, line, this->style_tags_enabled());
+            }
+        }
+
+        template <typename... Args>
+        inline void log_typed_module(const uint8_t module, const char* func, const char* file, const uint16_t line, 
+                                     const LOG_LEVEL_t level, const styled_message_t message, const Args&... args) {
+            if (this->is_enabled(level, module)) {
+                const log_typed_arg_t typed_args[] = {log_typed_arg(args)..., {}};
+                this->vlog_typed(level, this->style_tags_enabled() ? message.styled : message.plain, message.plain, 
+                                 typed_args, sizeof...(Args), func, file, line, false);
+            }
+        }
+
+        template <typename... Args>
+        inline void log_typed_site(const log_callsite_t* site, const uint8_t module, const char* message, const Args&... args) {
+            if (this->is_enabled(site, module)) {
+                const log_typed_arg_t typed_args[] = {log_typed_arg(args)..., {}};
+                this->vlog_typed((LOG_LEVEL_t) site->level, message, nullptr, typed_args, sizeof...(Args), 
+                                 site->func, site->file, site->line, this->style_tags_enabled());
+            }
+        }
+
+        template <typename... Args>
+        inline void log_typed_site(const log_callsite_t* site, const uint8_t module, const styled_message_t message, const Args&... args) {
+            if (this->is_enabled(site, module)) {
+                const log_typed_arg_t typed_args[] = {log_typed_arg(args)..., {}};
+                this->vlog_typed((LOG_LEVEL_t) site->level, this->style_tags_enabled() ? message.styled : message.plain, message.plain, 
+                                 typed_args, sizeof...(Args), site->func, site->file, site->line, false);
+            }
+        }
+
+        void set_module_level(const uint8_t module, const LOG_LEVEL_t level);
+        void set_module_level(const char* module, const LOG_LEVEL_t level);
+        void clear_module_level(const uint8_t module);
+        void clear_module_level(const char* module);
         bool reparse_format();
+        size_t drain();
+        uint32_t get_dropped_records();
+        uint32_t get_skipped_messages();
+        uint32_t get_truncated_messages();
+
+        #ifdef PICO_LOG_FREERTOS
+        bool start_log_task(const UBaseType_t priority = LOGGER_TASK_PRIORITY, 
+                            const configSTACK_DEPTH_TYPE stack_depth = LOGGER_TASK_STACK_SIZE);
+        #else
+        bool launch_core1_drain();
+        #endif
+
+        // Returns true if messages of the given level are enabled (for the given module).
+        inline bool is_enabled(const LOG_LEVEL_t level) {
+            return level >= this->options->logging_level;
+        }
+
+        inline bool is_enabled(const LOG_LEVEL_t level, const uint8_t module) {
+            const uint8_t module_level = this->module_levels[module & (LOGGER_MODULE_TABLE_SIZE - 1)];
+            return level >= ((module_level == MODULE_LEVEL_GLOBAL) ? (uint8_t) this->options->logging_level : module_level);
+        }
+
+        // Returns true if messages of a call site are enabled (forced, or enabled by its level).
+        inline bool is_enabled(const log_callsite_t* site) {
+            return *site->state == LOG_CALLSITE_FORCED || this->is_enabled((LOG_LEVEL_t) site->level);
+        }
+
+        inline bool is_enabled(const log_callsite_t* site, const uint8_t module) {
+            return *site->state == LOG_CALLSITE_FORCED || this->is_enabled((LOG_LEVEL_t) site->level, module);
+        }
     
     private:
-        stdio_driver_t* stdio_driver;
+        // Returns true if style tags in log messages are processed (replaced with ANSI escape codes,
+        // or removed for sinks without ANSI styling). Only if at least one sink uses ANSI styling.
+        inline bool style_tags_enabled() {
+            return this->options->process_style_tags && (this->options->ansi_styling || this->num_styled_sinks > 0);
+        }
+
+        // Returns true if a sink uses ANSI styling. The first sink uses the options.
+        inline bool sink_styled(const size_t sink_idx) {
+            return (sink_idx == 0) ? this->options->ansi_styling : this->sinks[sink_idx].ansi_styling;
+        }
+
+        // Returns true if messages of the given level are rendered with (or without) ANSI styling for any sink.
+        inline bool sinks_need_variant(const LOG_LEVEL_t level, const bool ansi_styling) {
+            for (size_t i = 0; i < this->num_sinks; i++) {
+                if (level >= this->sinks[i].level && this->sink_styled(i) == ansi_styling) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Output sink with its own minimum level and ANSI styling.
+        struct logger_sink {
+            log_sink_t sink;
+            LOG_LEVEL_t level;
+            bool ansi_styling;
+        };
+        typedef struct logger_sink logger_sink_t;
+
+        logger_sink_t sinks[LOGGER_MAX_SINKS];
+        size_t num_sinks = 1;
+        size_t num_styled_sinks = 0;
         logger_options_t* options;
 
         #ifdef PICO_LOG_FREERTOS
@@ -81,67 +367,235 @@ class Logger {
         mutex_t log_mutex;
         #endif
 
-        // Main log message buffers
+        // Seconds part of the last formatted timestamp.
+        // Only accessed while formatting, with the log mutex held.
+        struct timestamp_cache {
+            uint32_t sec = 0;
+            uint32_t sec_start_ms = 0;
+            char sec_str[10] = {'0'};
+            uint8_t sec_str_len = 1;
+        };
+        typedef struct timestamp_cache timestamp_cache_t;
+
+        timestamp_cache_t timestamp;
+
+        // Per-module log levels, indexed by log_module_id().
+        // Modules without an override use the global logging level.
+        static constexpr uint8_t MODULE_LEVEL_GLOBAL = 0xFF;
+        uint8_t module_levels[LOGGER_MODULE_TABLE_SIZE];
+
+        // Main log message buffer. The message is formatted directly into its position in the output.
         char output_buff[LOGGER_BUFF_SIZE];
-        char tmp_buff[LOGGER_BUFF_SIZE];
-
-        enum COLOR {
-            COLOR_BLACK,
-            COLOR_RED,
-            COLOR_GREEN,
-            COLOR_YELLOW,
-            COLOR_BLUE,
-            COLOR_MAGENTA,
-            COLOR_CYAN,
-            COLOR_WHITE
+
+        // Log format tokens, plain and styled (indexed by ANSI styling).
+        #ifndef PICO_LOG_STATIC_FORMAT
+        log_format_token_t log_format_tokens[2][LOG_FORMAT_MAX_TOKENS];
+        char log_format_arena[2][LOG_FORMAT_ARENA_SIZE];
+        #endif
+
+        // Call-site information of a log message.
+        struct log_context {
+            const char* func;
+            const char* file;
+            uint16_t line;
+            LOG_LEVEL_t level;
+            uint32_t timestamp_ms;
+            uint8_t core;
+            const char* task;
+        };
+        typedef struct log_context log_context_t;
+
+        enum LOG_MESSAGE_TYPE {
+            MESSAGE_TEXT,
+            MESSAGE_VA_LIST,
+            MESSAGE_CAPTURED,
+            MESSAGE_TYPED
+        };
+
+        // Log message and its arguments, formatted at the %MSG% token.
+        // Sinks without ANSI styling use plain_format if set (compile-time styled messages),
+        // and have processed style tags removed instead of translated.
+        struct log_message {
+            LOG_MESSAGE_TYPE type;
+            const char* format;
+            const char* plain_format = nullptr;
+            bool proc_style_tags = false;
+            va_list* va_args = nullptr;
+            const uint8_t* captured_args = nullptr;
+            size_t captured_args_len = 0;
+            const log_typed_arg_t* typed_args = nullptr;
+            size_t num_typed_args = 0;
+        };
+        typedef struct log_message log_message_t;
+
+        enum LOG_RECORD_FLAGS {
+            RECORD_FLAG_PADDING    = (1 << 0),
+            RECORD_FLAG_STYLE_TAGS = (1 << 1),
+            RECORD_FLAG_TEXT       = (1 << 2),
+            RECORD_FLAG_PLAIN      = (1 << 3),
+            RECORD_FLAG_TOKEN      = (1 << 4)
         };
 
-        struct color_spec {
-            COLOR color;
-            bool background;
-            bool high_intensity;
-            bool success;
+        enum LOG_RECORD_STATE {
+            RECORD_STATE_RESERVED,
+            RECORD_STATE_COMMITTED
         };
-        typedef struct color_spec color_spec_t;
-
-        enum LOG_FORMAT_TOKEN_TYPE {
-            FORMAT_TOKEN_END,
-            FORMAT_TOKEN_TEXT,
-            FORMAT_TOKEN_STYLE,
-            FORMAT_TOKEN_COLOR,
-            FORMAT_TOKEN_FUNC,
-            FORMAT_TOKEN_FILE,
-            FORMAT_TOKEN_LINE,
-            FORMAT_TOKEN_TASK,
-            FORMAT_TOKEN_CORE,
-            FORMAT_TOKEN_LEVEL,
-            FORMAT_TOKEN_TIMESTAMP,
-            FORMAT_TOKEN_MSG,
+
+        // Log record header, followed by the captured arguments (or by the null-terminated message, for text records).
+        // With RECORD_FLAG_PLAIN, they are followed by the plain message pointer (or the plain text).
+        struct log_record {
+            uint16_t size;
+            uint8_t flags;
+            volatile uint8_t state;
+            uint16_t line;
+            uint8_t level;
+            uint8_t core;
+            uint8_t args_len;
+            uint32_t timestamp_ms;
+            const char* func;
+            const char* file;
+            const char* message;
+            #ifdef PICO_LOG_FREERTOS
+            char task_name[configMAX_TASK_NAME_LEN];
+            #endif
+        };
+        typedef struct log_record log_record_t;
+
+        static_assert((LOGGER_RECORD_BUFF_SIZE & (LOGGER_RECORD_BUFF_SIZE - 1)) == 0, "LOGGER_RECORD_BUFF_SIZE must be a power of two");
+        static_assert(LOGGER_RECORD_ARGS_SIZE <= UINT8_MAX, "LOGGER_RECORD_ARGS_SIZE must not exceed 255");
+        static_assert(LOGGER_RECORD_TEXT_SIZE >= 32, "LOGGER_RECORD_TEXT_SIZE must be at least 32");
+        static_assert(sizeof(log_record_t) + 2 * LOGGER_RECORD_TEXT_SIZE <= LOGGER_RECORD_BUFF_SIZE, 
+                      "LOGGER_RECORD_TEXT_SIZE is too large for LOGGER_RECORD_BUFF_SIZE");
+
+        // Multi-producer, single-consumer log record ring buffer.
+        // Producers reserve space while holding record_lock (only for the index update),
+        // then write and commit their record without it. The consumer (log mutex holder) is lock-free.
+        alignas(log_record_t) uint8_t record_buff[LOGGER_RECORD_BUFF_SIZE];
+        std::atomic<uint32_t> record_head = 0;
+        std::atomic<uint32_t> record_tail = 0;
+        uint32_t records_dropped = 0;
+        spin_lock_t* record_lock;
+
+        // Messages dropped by the lock policy (counted while holding record_lock),
+        // and the total number of dropped messages at the last "messages dropped" line.
+        uint32_t messages_skipped = 0;
+        uint32_t dropped_reported = 0;
+
+        // Messages truncated when queued as text (counted while holding record_lock),
+        // and the number of truncated messages at the last "messages truncated" line.
+        uint32_t messages_truncated = 0;
+        uint32_t truncated_reported = 0;
+
+        // Last message (call site, format and hash of its arguments) and its number of repeats,
+        // for collapsing identical consecutive messages. Only accessed while holding record_lock.
+        struct repeat_state {
+            const char* message = nullptr;
+            uint32_t args_hash = 0;
+            uint32_t count = 0;
+            uint32_t since_ms = 0;  // Time of the first repeat not logged yet.
+            const char* func = nullptr;
+            const char* file = nullptr;
+            uint16_t line = 0;
+            LOG_LEVEL_t level = LOG_LVL_DEBUG;
         };
+        typedef struct repeat_state repeat_state_t;
+
+        repeat_state_t last_message;
+        static constexpr const char* REPEAT_MESSAGE = "Previous message repeated {} times";
+
+        #ifdef PICO_LOG_TOKENIZED
+        // Tokenized record payload: token ID and captured arguments (the timestamp is added when it is output).
+        static constexpr size_t TOKEN_PAYLOAD_SIZE = sizeof(uint32_t) + LOGGER_RECORD_ARGS_SIZE;
+        static_assert(TOKEN_PAYLOAD_SIZE <= UINT8_MAX, "LOGGER_RECORD_ARGS_SIZE must not exceed 251 in tokenized mode");
 
-        // Log format pre-parser token structure.
-        struct log_format_token {
-            LOG_FORMAT_TOKEN_TYPE type = FORMAT_TOKEN_END;
-            uint8_t color_code = 0;
-            const char* str_ptr = nullptr;
-            size_t txt_token_len = 0;
+        // Encoded frame (text frames are the largest), and the timestamp state of tokenized records.
+        // Only accessed with the log mutex held.
+        uint8_t frame_buff[log_wire_frame_len(sizeof(uint32_t) + LOGGER_BUFF_SIZE)];
+        uint32_t token_last_ms = 0;
+        uint32_t token_count = 0;
+
+        static_assert(TOKEN_PAYLOAD_SIZE + LOG_WIRE_VARINT_MAX_LEN <= sizeof(uint32_t) + LOGGER_BUFF_SIZE, 
+                      "LOGGER_BUFF_SIZE is too small for tokenized records");
+        #endif
+
+        // Outcome of taking the log mutex for a message, according to the lock policy.
+        enum LOG_LOCK_RESULT {
+            LOCK_TAKEN,
+            LOCK_QUEUE,
+            LOCK_SKIPPED
         };
-        typedef struct log_format_token log_format_token_t;
 
-        log_format_token_t log_format_tokens[LOG_FORMAT_MAX_TOKENS];
+        // Set when records are output by a background drain engine.
+        // All messages are then handed to it instead of being output by the caller.
+        bool drain_engine_active = false;
+
+        #ifdef PICO_LOG_FREERTOS
+        TaskHandle_t log_task = nullptr;
+        static void log_task_entry(void* param);
+        #else
+        static Logger* core1_drain_logger;
+        static void core1_drain_entry();
+        #endif
+
+        static void stdio_out_chars(void* ctx, const char* buf, size_t len);
 
         inline bool take_log_mutex();
+        inline bool try_take_log_mutex();
+        inline bool take_log_mutex_timeout(const uint32_t timeout_us);
+        inline LOG_LOCK_RESULT lock_message();
+        inline bool repeat_check(const LOG_LEVEL_t level, const char* message, const uint32_t args_hash, 
+                                 const char* func, const char* file, const uint16_t line);
         inline void release_log_mutex();
+        inline void release_log_mutex_drain();
+
+        inline void vlog_msg(const LOG_LEVEL_t level, const char* message, const char* plain_message, va_list args, 
+                             const char* func, const char* file, const uint16_t line, const bool proc_style_tags);
+        inline void vlog_isr(const LOG_LEVEL_t level, const char* message, const char* plain_message, va_list args, 
+                             const char* func, const char* file, const uint16_t line, const bool proc_style_tags);
+        void vlog_typed(const LOG_LEVEL_t level, const char* message, const char* plain_message, 
+                        const log_typed_arg_t* args, const size_t num_args, 
+                        const char* func, const char* file, const uint16_t line, const bool proc_style_tags);
+        #ifdef PICO_LOG_TOKENIZED
+        inline void vlog_token(const log_token_t* token, va_list args);
+        inline void record_push_token(const log_context_t& ctx, const uint8_t* payload, const size_t payload_len);
+        inline void token_output(const LOG_LEVEL_t level, const uint32_t timestamp_ms, const uint8_t* payload, const size_t payload_len);
+        inline size_t frame_encode(const uint8_t* payload, const size_t payload_len, const bool text);
+        #endif
+        inline log_context_t make_context(const LOG_LEVEL_t level, const char* func, const char* file, const uint16_t line);
+        inline log_record_t* record_reserve(const uint32_t record_size);
+        inline void record_commit(log_record_t* record);
+        inline bool record_pending();
+        inline void record_notify(const bool from_isr);
+        inline log_record_t* record_create(const log_context_t& ctx, const size_t data_len, const uint8_t flags);
+        inline void record_push(const log_context_t& ctx, const char* message, const char* plain_message, 
+                                va_list args, const bool proc_style_tags, const bool from_isr);
+        inline void record_push_text(const log_context_t& ctx, const char* message, const char* plain_message, 
+                                     const log_typed_arg_t* args, const size_t num_args, const bool proc_style_tags);
+        inline void record_push_text(const log_context_t& ctx, const char* message, const char* plain_message, 
+                                     va_list args, const bool proc_style_tags);
+        inline void record_push_chars(const log_context_t& ctx, const char* text, const size_t len, const bool plain, const bool truncated);
+        inline void record_output(const log_record_t* record);
+        inline size_t record_output_all();
+        inline void report_dropped();
+        inline void report_count(const uint32_t count, uint32_t& reported, const char* what);
+        inline void report_repeats();
+        inline void msg_output(const log_context_t& ctx, const log_message_t& msg);
         
+        #ifndef PICO_LOG_STATIC_FORMAT
         void msg_format_tokenize();
         void clear_format_tokens();
+        #else
+        template <bool ansi_styling, size_t... token_idx>
+        inline void msg_process_static_format(log_output_t& out, const log_message_t& msg, const log_context_t& ctx, 
+                                              std::index_sequence<token_idx...>);
+        #endif
         
-        inline color_spec_t process_color_spec(const COLOR color, const char* &src_ptr, const size_t ptr_skip);
-        inline size_t msg_process_format(char* buff, const size_t buff_size, const char* msg, const LOG_LEVEL_t level, 
-                                         const char* func, const char* file, const uint16_t line);
-        inline void msg_process_style(const char* src_ptr, char* buff, const size_t buff_size);
+        inline void msg_process_format(log_output_t& out, const log_message_t& msg, const log_context_t& ctx, const bool ansi_styling);
+        inline void msg_format_end(log_output_t& out);
+        inline uint32_t timestamp_update(const uint32_t timestamp_ms);
         
-        constexpr const char* log_lvl_str(const LOG_LEVEL_t level);
-        constexpr uint8_t log_lvl_color(const LOG_LEVEL_t level);
-        constexpr uint8_t ansi_color_code(const color_spec_t clr_spec);
+        template <LOG_FORMAT_TOKEN_TYPE type>
+        inline void msg_format_token(const log_format_token_t& token, log_output_t& out, 
+                                     const log_message_t& msg, const log_context_t& ctx, const bool ansi_styling);
+        inline void msg_write(log_output_t& out, const log_message_t& msg, const bool ansi_styling);
 };
\ No newline at end of file
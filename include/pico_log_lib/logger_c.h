@@ -23,11 +23,48 @@
 #include "pico/stdlib.h"
 #include "pico/stdio/driver.h"
 #include "pico_log_lib/internal/common.h"
+#include "pico_log_lib/callsites.h"
+#include "pico_log_lib/ratelimit.h"
+#include "pico_log_lib/sink.h"
+
+#ifdef PICO_LOG_FREERTOS
+#include "FreeRTOS.h"
+#endif
 
 
 // Opaque logger handle type.
 typedef void* logger_handle_t;
 
+// Module table index used by the logging macros (see logger_module_id()), e.g. a global variable.
+// If defined before including this header, the macros log with logger_log_module().
+// Call sites registered with PICO_LOG_CALLSITES always use the global logging level.
+#if defined(PICO_LOG_CALLSITES)
+    #define LOGGER_LOG_CALL(logger, level, ...) PICO_LOG_CALLSITE(level, logger_log_site(logger, &pico_log_site, __VA_ARGS__))
+#elif defined(LOGGER_MODULE)
+    #define LOGGER_LOG_CALL(logger, level, ...) logger_log_module(logger, LOGGER_MODULE, __func__, __FILE__, __LINE__, level, __VA_ARGS__)
+#else
+    #define LOGGER_LOG_CALL(logger, level, ...) logger_log(logger, __func__, __FILE__, __LINE__, level, __VA_ARGS__)
+#endif
+
+// Logging macros. Calls below PICO_LOG_COMPILE_LEVEL are removed at compile-time.
+#define LOGGER_LOG_DEBUG(logger, ...) PICO_LOG_IF_DEBUG(LOGGER_LOG_CALL(logger, LOG_LVL_DEBUG, __VA_ARGS__))
+#define LOGGER_LOG_INFO(logger, ...)  PICO_LOG_IF_INFO(LOGGER_LOG_CALL(logger, LOG_LVL_INFO, __VA_ARGS__))
+#define LOGGER_LOG_WARN(logger, ...)  PICO_LOG_IF_WARN(LOGGER_LOG_CALL(logger, LOG_LVL_WARN, __VA_ARGS__))
+#define LOGGER_LOG_ERROR(logger, ...) PICO_LOG_IF_ERROR(LOGGER_LOG_CALL(logger, LOG_LVL_ERROR, __VA_ARGS__))
+#define LOGGER_LOG_FATAL(logger, ...) PICO_LOG_IF_FATAL(LOGGER_LOG_CALL(logger, LOG_LVL_FATAL, __VA_ARGS__))
+
+// Logs at the given level (DEBUG, INFO, WARN, ERROR or FATAL), e.g. LOGGER_LOG(logger, INFO, "Hello").
+#define LOGGER_LOG(logger, lvl, ...) LOGGER_LOG_##lvl(logger, __VA_ARGS__)
+
+// Rate-limited logging at the given level (see ratelimit.h), e.g. LOGGER_LOG_EVERY_N(logger, WARN, 100, "Fault: %d", code).
+#define LOGGER_LOG_ONCE(logger, lvl, ...)              PICO_LOG_IF_##lvl(PICO_LOG_LIMIT_ONCE(LOGGER_LOG_CALL(logger, LOG_LVL_##lvl, __VA_ARGS__)))
+#define LOGGER_LOG_EVERY_N(logger, lvl, n, ...)        PICO_LOG_IF_##lvl(PICO_LOG_LIMIT_EVERY_N(n, LOGGER_LOG_CALL(logger, LOG_LVL_##lvl, __VA_ARGS__)))
+#define LOGGER_LOG_RATE(logger, lvl, rate, burst, ...) PICO_LOG_IF_##lvl(PICO_LOG_LIMIT_RATE(rate, burst, LOGGER_LOG_CALL(logger, LOG_LVL_##lvl, __VA_ARGS__)))
+
+// Logs from an interrupt handler at the given level, e.g. LOGGER_LOG_ISR(logger, WARN, "Overrun: %u", count).
+#define LOGGER_LOG_ISR(logger, lvl, ...) \
+    PICO_LOG_IF_##lvl(logger_log_from_isr(logger, __func__, __FILE__, __LINE__, LOG_LVL_##lvl, __VA_ARGS__))
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +80,18 @@ extern "C" {
      * @return Initialized logger object handle or nullptr if memory allocation fails.
      */
     logger_handle_t logger_init(stdio_driver_t* stdio_driver, logger_options_t* options);
+
+    /**
+     * @brief Initializes a logger instance with the specified output sink and options.
+     *
+     * Same as logger_init(), but log messages are written to the sink instead of a stdio driver.
+     * If the sink provides out_segments, messages are passed to it as a list of segments.
+     *
+     * @param sink Pointer to the output sink (copied, out_chars is required).
+     * @param options Pointer to the logger_options structure containing configuration parameters.
+     * @return Initialized logger object handle or nullptr if memory allocation fails.
+     */
+    logger_handle_t logger_init_sink(const log_sink_t* sink, logger_options_t* options);
     
     /**
      * @brief Destroys the logger instance and frees associated resources.
@@ -66,6 +115,54 @@ extern "C" {
      */
     bool logger_init_mutex(logger_handle_t logger);
 
+    /**
+     * @brief Adds an output sink to the logger.
+     *
+     * Messages at or above the given level (that pass the logger's own level filters) are also
+     * written to the sink, with or without ANSI styling. Each variant is formatted once per message.
+     *
+     * @param logger Logger object handle.
+     * @param sink Pointer to the output sink (copied, out_chars is required).
+     * @param level Minimum severity of the messages written to the sink.
+     * @param ansi_styling Whether messages are written to the sink with ANSI styling.
+     * @return True if the sink was added, false if LOGGER_MAX_SINKS sinks are already in use.
+     */
+    bool logger_add_sink(logger_handle_t logger, const log_sink_t* sink, const LOG_LEVEL_t level, const bool ansi_styling);
+
+    /**
+     * @brief Returns the module table index of a module name.
+     *
+     * Only the part of the name after the last path separator is used,
+     * so __FILE__ can be used as a module name. The result should be stored
+     * and passed to logger_log_module(), rather than computed for every message.
+     *
+     * @param module Module name.
+     * @return Module table index.
+     */
+    uint8_t logger_module_id(const char* module);
+
+    /**
+     * @brief Sets the log level of a module.
+     *
+     * Messages logged with logger_log_module() for this module are filtered
+     * with this level instead of the global logging level.
+     *
+     * @param logger Logger object handle.
+     * @param module Module table index (see logger_module_id()).
+     * @param level Log verbosity level of the module.
+     */
+    void logger_set_module_level(logger_handle_t logger, const uint8_t module, const LOG_LEVEL_t level);
+
+    /**
+     * @brief Clears the log level of a module.
+     *
+     * The module uses the global logging level again.
+     *
+     * @param logger Logger object handle.
+     * @param module Module table index (see logger_module_id()).
+     */
+    void logger_clear_module_level(logger_handle_t logger, const uint8_t module);
+
     /**
      * @brief Reparses the log format string of the logger.
      *
@@ -77,6 +174,78 @@ extern "C" {
      *         false if the mutex could not be acquired.
      */
     bool logger_reparse_format(logger_handle_t logger);
+
+    /**
+     * @brief Outputs all queued deferred log records.
+     *
+     * This function formats and outputs the log records queued while deferred logging
+     * is enabled, oldest first. It should be called periodically from a non time-critical context.
+     *
+     * @param logger Logger object handle.
+     * @return The number of log records output.
+     */
+    size_t logger_drain(logger_handle_t logger);
+
+    /**
+     * @brief Returns the number of deferred log records dropped.
+     *
+     * Deferred log records are dropped when the record buffer is full.
+     *
+     * @param logger Logger object handle.
+     * @return The total number of dropped deferred log records.
+     */
+    uint32_t logger_get_dropped_records(logger_handle_t logger);
+
+    /**
+     * @brief Returns the number of log messages skipped by the lock policy.
+     *
+     * With the LOG_LOCK_TRY and LOG_LOCK_TIMEOUT lock policies, messages are skipped 
+     * when another core or task is writing to the sinks.
+     *
+     * @param logger Logger object handle.
+     * @return The total number of skipped log messages.
+     */
+    uint32_t logger_get_skipped_messages(logger_handle_t logger);
+
+    /**
+     * @brief Returns the number of log messages truncated when queued as text.
+     *
+     * Messages queued as text (see LOGGER_RECORD_TEXT_SIZE) are cut at LOGGER_RECORD_TEXT_SIZE - 1 characters,
+     * and end with "[...]".
+     *
+     * @param logger Logger object handle.
+     * @return The total number of truncated log messages.
+     */
+    uint32_t logger_get_truncated_messages(logger_handle_t logger);
+
+    #ifdef PICO_LOG_FREERTOS
+    /**
+     * @brief Starts the background log task.
+     *
+     * The log task blocks until a record is committed, then styles, formats and outputs it.
+     * All messages are handed to the task through the record buffer, as in deferred logging mode,
+     * so logging never blocks the calling task. This also initializes the logger's mutex.
+     *
+     * @param logger Logger object handle.
+     * @param priority Priority of the log task (should normally be low, e.g. tskIDLE_PRIORITY + 1).
+     * @param stack_depth Stack depth of the log task, in words.
+     * @return true if the task was created, false if it is already running or could not be created.
+     */
+    bool logger_start_log_task(logger_handle_t logger, const UBaseType_t priority, const configSTACK_DEPTH_TYPE stack_depth);
+    #else
+    /**
+     * @brief Launches the log drain engine on core 1.
+     *
+     * Core 1 is dedicated to outputting the logger's messages: it sleeps until a record
+     * is committed, then styles, formats and outputs it. All messages are handed to core 1
+     * through the record buffer, as in deferred logging mode. This also initializes the logger's mutex.
+     * Only one logger can use the core 1 drain engine, and core 1 must not be otherwise in use.
+     *
+     * @param logger Logger object handle.
+     * @return true if core 1 was launched, false if the core 1 drain engine is already in use.
+     */
+    bool logger_launch_core1_drain(logger_handle_t logger);
+    #endif
     
     /**
      * @brief Logs a formatted message with the specified log verbosity.
@@ -108,7 +277,56 @@ extern "C" {
      * @param line Line number in the source file where the log is called.
      */
     void logger_vlog(logger_handle_t logger, const LOG_LEVEL_t level, const char* message, va_list args, 
-                     const char* func, const char* file, const uint16_t line);    
+                     const char* func, const char* file, const uint16_t line);
+
+    /**
+     * @brief Logs a formatted message from an interrupt handler.
+     *
+     * The message and its arguments are queued in the deferred record buffer in bounded time,
+     * without taking the logger's mutex. The message is formatted and output later from thread
+     * context, by logger_drain(), the next log call or the background drain engine.
+     * Messages that do not fit are counted by logger_get_dropped_records().
+     *
+     * @param logger Logger object handle.
+     * @param func Function name where the log is called.
+     * @param file Source file name where the log is called.
+     * @param line Line number in the source file where the log is called.
+     * @param level Log verbosity level.
+     * @param message Log message (supports format specifiers).
+     * @param ... Additional arguments for the format string.
+     */
+    void logger_log_from_isr(logger_handle_t logger, const char* func, const char* file, const uint16_t line, 
+                             const LOG_LEVEL_t level, const char* message, ...);
+
+    /**
+     * @brief Logs a formatted message of a module with the specified log verbosity.
+     *
+     * Same as logger_log(), except that the message is filtered with the
+     * module's log level (see logger_set_module_level()), if it has one.
+     *
+     * @param logger Logger object handle.
+     * @param module Module table index (see logger_module_id()).
+     * @param func Function name where the log is called.
+     * @param file Source file name where the log is called.
+     * @param line Line number in the source file where the log is called.
+     * @param level Log verbosity level.
+     * @param message Log message (supports format specifiers).
+     */
+    void logger_log_module(logger_handle_t logger, const uint8_t module, const char* func, const char* file, const uint16_t line, 
+                           const LOG_LEVEL_t level, const char* message, ...);
+
+    /**
+     * @brief Logs a formatted message from a registered call site.
+     *
+     * The call site's function name, file name, line number and log level are used.
+     * The message is output if the call site is forced on, or if its level is enabled.
+     * This is normally called through the logging macros (see PICO_LOG_CALLSITE()).
+     *
+     * @param logger Logger object handle.
+     * @param site Call-site descriptor.
+     * @param message Log message (supports format specifiers).
+     */
+    void logger_log_site(logger_handle_t logger, const log_callsite_t* site, const char* message, ...);    
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,91 @@
+/*
+    Pico Log - Log rate limiting.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// Token bucket state of a rate-limited call site.
+// Zero-initialized (static) state is a full bucket.
+typedef struct {
+    uint32_t last_ms; // Time of the last refill.
+    uint32_t used;    // Tokens taken from the bucket, in thousandths of a token.
+} log_rate_limit_t;
+
+
+/*
+    Call-site rate limiting. Each macro keeps its state in a static variable next to the call,
+    and only evaluates call if it is allowed, so suppressed calls never reach the logger.
+    The state is not synchronized, calls from several cores at once may let an extra message through.
+    Calls are counted before any log level filtering.
+*/
+
+// Evaluates call the first time only.
+#define PICO_LOG_LIMIT_ONCE(call)                                                                                      \
+    __extension__ ({                                                                                                   \
+        static volatile bool pico_log_limit_done = false;                                                              \
+        if (!pico_log_limit_done) {                                                                                    \
+            pico_log_limit_done = true;                                                                                \
+            call;                                                                                                      \
+        }                                                                                                              \
+    })
+
+// Evaluates call the first time, and then every n-th time.
+#define PICO_LOG_LIMIT_EVERY_N(n, call)                                                                                \
+    __extension__ ({                                                                                                   \
+        static volatile uint32_t pico_log_limit_count = 0;                                                             \
+        const uint32_t pico_log_limit_num = pico_log_limit_count;                                                      \
+        pico_log_limit_count = pico_log_limit_num + 1;                                                                 \
+        if (pico_log_limit_num % (uint32_t) (n) == 0) {                                                                \
+            call;                                                                                                      \
+        }                                                                                                              \
+    })
+
+// Evaluates call at most rate times per second on average, with bursts of up to burst calls.
+#define PICO_LOG_LIMIT_RATE(rate, burst, call)                                                                         \
+    __extension__ ({                                                                                                   \
+        static log_rate_limit_t pico_log_limit_bucket;                                                                 \
+        if (log_rate_limit_take(&pico_log_limit_bucket, (rate), (burst))) {                                            \
+            call;                                                                                                      \
+        }                                                                                                              \
+    })
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /**
+     * @brief Takes a token from a rate limiter's token bucket.
+     *
+     * The bucket holds up to burst tokens, and is refilled with rate tokens per second.
+     *
+     * @param limit Rate limiter state.
+     * @param rate Number of tokens added per second.
+     * @param burst Bucket size (maximum number of tokens).
+     * @return True if a token was taken (the call is allowed), false if the bucket is empty.
+     */
+    bool log_rate_limit_take(log_rate_limit_t* limit, const uint32_t rate, const uint32_t burst);
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
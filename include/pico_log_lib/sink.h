@@ -0,0 +1,43 @@
+/*
+    Pico Log - Log output sinks.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include <stddef.h>
+
+
+// Contiguous piece of a formatted log message.
+typedef struct {
+    const char* data;
+    size_t len;
+} log_segment_t;
+
+/*
+    Log output destination. out_chars is required, out_segments is optional.
+    If out_segments is provided, each formatted message is passed to it as a list of
+    segments instead. Constant parts of the message (log format text, ANSI escape codes,
+    level labels, function and file names) are then not copied into the log buffer first.
+    Segments are only valid for the duration of the call. ctx is passed to both functions.
+*/
+typedef struct {
+    void* ctx;
+    void (*out_chars)(void* ctx, const char* buf, size_t len);
+    void (*out_segments)(void* ctx, const log_segment_t* segments, size_t num_segments);
+} log_sink_t;
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*
+    Pico Log - Flash ring sink.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+#include "pico/stdlib.h"
+#include "pico_log_lib/sink.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// Number of page buffers in RAM. Messages are batched into these, until the pages
+// are programmed by flash_ring_sink_service(). Messages are dropped if all of them are full.
+#ifndef FLASH_RING_SINK_PAGES
+    #define FLASH_RING_SINK_PAGES 4
+#endif
+
+// Maximum time (in milliseconds) to wait for the other core (or tasks) to stop executing from flash.
+#ifndef FLASH_RING_SINK_SAFE_TIMEOUT_MS
+    #define FLASH_RING_SINK_SAFE_TIMEOUT_MS 100
+#endif
+
+// Page header magic number ("PLOG").
+#define FLASH_RING_SINK_MAGIC 0x474F4C50u
+
+// Flash page header. Erased pages read as all ones.
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;      // Sequence number, incremented for every programmed page.
+    uint32_t len;      // Number of log bytes in the page.
+    uint32_t checksum; // Checksum of the sequence number, length and log bytes.
+} flash_ring_page_header_t;
+
+#define FLASH_RING_SINK_PAGE_DATA (FLASH_PAGE_SIZE - sizeof(flash_ring_page_header_t))
+
+// Flash page, and its RAM buffer.
+typedef struct {
+    flash_ring_page_header_t header;
+    char data[FLASH_RING_SINK_PAGE_DATA];
+} flash_ring_page_t;
+
+/*
+    Flash ring sink state. Messages are copied into RAM page buffers, and full pages
+    are programmed into a reserved flash region by flash_ring_sink_service(), called
+    outside of the logging path (e.g. from a low-priority task or the main loop).
+    The region is written as a circular log, one page after the other, and each sector
+    is erased right before its first page is programmed, so all sectors wear evenly.
+*/
+typedef struct {
+    uint32_t flash_offset;      // Region start, from the start of flash.
+    uint32_t num_pages;         // Region size in pages.
+    uint32_t write_page;        // Next page to program, in the region.
+    uint32_t next_seq;          // Sequence number of the next programmed page.
+    flash_ring_page_t pages[FLASH_RING_SINK_PAGES];
+    volatile uint32_t head;     // Number of full pages (pages[head % FLASH_RING_SINK_PAGES] is being filled).
+    volatile uint32_t tail;     // Number of programmed pages.
+    uint32_t fill_len;          // Number of log bytes in the page being filled.
+    volatile uint32_t dropped;  // Number of dropped bytes.
+    spin_lock_t* lock;
+} flash_ring_sink_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /**
+     * @brief Initializes a flash ring sink, and scans its flash region for the log of previous runs.
+     *
+     * New pages are programmed after the newest valid page found in the region,
+     * previous runs' pages are kept until their sector is reused.
+     *
+     * @param sink Sink state to initialize.
+     * @param flash_offset Region start, from the start of flash (multiple of FLASH_SECTOR_SIZE).
+     * @param size Region size (multiple of FLASH_SECTOR_SIZE). The region must not be used by the program.
+     * @return True on success, false if the region is not aligned to sectors.
+     */
+    bool flash_ring_sink_init(flash_ring_sink_t* sink, uint32_t flash_offset, uint32_t size);
+
+    /**
+     * @brief Returns the log sink of a flash ring sink, to be passed to the Logger constructor, add_sink() or logger_init_sink().
+     *
+     * @param sink Initialized sink state.
+     * @return Log sink writing to the flash ring sink.
+     */
+    log_sink_t flash_ring_sink_get(flash_ring_sink_t* sink);
+
+    /**
+     * @brief Programs the full pages into flash, erasing sectors as needed.
+     *
+     * Uses flash_safe_execute(), the other core (if running) must have called flash_safe_execute_core_init().
+     * Should be called periodically, outside of time-critical code. Must not be called concurrently with itself.
+     *
+     * @param sink Initialized sink state.
+     * @return Number of pages programmed.
+     */
+    size_t flash_ring_sink_service(flash_ring_sink_t* sink);
+
+    /**
+     * @brief Programs all queued messages into flash, including the page being filled.
+     *
+     * Must not be called concurrently with the logger using the sink.
+     *
+     * @param sink Initialized sink state.
+     */
+    void flash_ring_sink_flush(flash_ring_sink_t* sink);
+
+    /**
+     * @brief Copies the log stored in flash, oldest page first.
+     *
+     * @param sink Initialized sink state.
+     * @param offset Offset of the first byte to copy, from the oldest byte stored in flash.
+     * @param buff Destination buffer (not null-terminated).
+     * @param size Destination buffer size.
+     * @return Number of bytes copied, 0 once offset reaches the end of the log.
+     */
+    size_t flash_ring_sink_read(const flash_ring_sink_t* sink, size_t offset, char* buff, size_t size);
+
+    /**
+     * @brief Returns the number of bytes dropped because all page buffers were full.
+     *
+     * @param sink Initialized sink state.
+     * @return Number of dropped bytes.
+     */
+    uint32_t flash_ring_sink_get_dropped(const flash_ring_sink_t* sink);
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+/*
+    Pico Log - Crash-persistent RAM ring sink.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+#include "pico_log_lib/sink.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// Ring buffer size (must be a power of two).
+#ifndef RAM_RING_SINK_BUFF_SIZE
+    #define RAM_RING_SINK_BUFF_SIZE 4096
+#endif
+
+// Header magic number of an initialized ring ("PLG2", changed with the header layout).
+#define RAM_RING_SINK_MAGIC 0x32474C50u
+
+// Defines a RAM ring sink in the .uninitialized_data section, which is not cleared at boot,
+// so the log of the previous run survives resets (but not power cycles), e.g. static RAM_RING_SINK_DEFINE(crash_log);
+#define RAM_RING_SINK_DEFINE(name) ram_ring_sink_t __uninitialized_ram(name)
+
+// State of the log found in a ring at boot.
+typedef enum {
+    RAM_RING_SINK_EMPTY,  // No log (e.g. after a power cycle).
+    RAM_RING_SINK_VALID,  // Log of the previous run.
+    RAM_RING_SINK_CORRUPT // Log of the previous run, but the reset happened while a message was appended (the interrupted message is left out).
+} RAM_RING_SINK_STATE_t;
+
+/*
+    RAM ring sink state. Messages are copied into the ring buffer, overwriting the oldest ones,
+    so the buffer always holds the last RAM_RING_SINK_BUFF_SIZE bytes of the log.
+    Before a message is copied, its length is recorded in the header as pending, and it is cleared once
+    the head has been moved past the message, so a reset during the copy is detected. The header is
+    protected by a checksum, which is updated with each header change.
+    Must be placed in uninitialized memory (see RAM_RING_SINK_DEFINE).
+*/
+typedef struct {
+    uint32_t magic;
+    uint32_t size;
+    volatile uint32_t head;     // Total number of bytes written (wraps around).
+    volatile uint32_t pending;  // Length of the message being appended, 0 between messages.
+    volatile uint32_t checksum; // Header checksum.
+    char buff[RAM_RING_SINK_BUFF_SIZE];
+} ram_ring_sink_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /**
+     * @brief Checks whether a ring holds the log of the previous run.
+     *
+     * Should be called at boot, before ram_ring_sink_init().
+     *
+     * @param sink Sink state, in uninitialized memory.
+     * @return State of the log found in the ring.
+     */
+    RAM_RING_SINK_STATE_t ram_ring_sink_check(const ram_ring_sink_t* sink);
+
+    /**
+     * @brief Returns the number of log bytes held by a ring.
+     *
+     * @param sink Sink state holding a log (see ram_ring_sink_check()).
+     * @return Number of bytes that can be read with ram_ring_sink_read().
+     */
+    size_t ram_ring_sink_len(const ram_ring_sink_t* sink);
+
+    /**
+     * @brief Copies log bytes out of a ring, oldest first.
+     *
+     * The oldest message may be cut off at the start, as it was partially overwritten.
+     * If the ring is corrupt, the interrupted message and the bytes it overwrote are left out.
+     *
+     * @param sink Sink state holding a log (see ram_ring_sink_check()).
+     * @param offset Offset of the first byte to copy, from the oldest byte held by the ring.
+     * @param buff Destination buffer (not null-terminated).
+     * @param size Destination buffer size.
+     * @return Number of bytes copied, 0 once offset reaches ram_ring_sink_len().
+     */
+    size_t ram_ring_sink_read(const ram_ring_sink_t* sink, size_t offset, char* buff, size_t size);
+
+    /**
+     * @brief Initializes a RAM ring sink, discarding the log of the previous run.
+     *
+     * @param sink Sink state to initialize.
+     */
+    void ram_ring_sink_init(ram_ring_sink_t* sink);
+
+    /**
+     * @brief Returns the log sink of a RAM ring sink, to be passed to the Logger constructor, add_sink() or logger_init_sink().
+     *
+     * @param sink Initialized sink state.
+     * @return Log sink writing to the RAM ring sink.
+     */
+    log_sink_t ram_ring_sink_get(ram_ring_sink_t* sink);
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
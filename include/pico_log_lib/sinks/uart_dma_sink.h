@@ -0,0 +1,118 @@
+/*
+    Pico Log - DMA-driven UART sink.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+#include "hardware/sync.h"
+#include "hardware/uart.h"
+#include "pico_log_lib/sink.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// Size of the ring buffer of each UART DMA sink in bytes (must be a power of two).
+// The buffer is aligned to its size, as required by the DMA read ring.
+#ifndef UART_DMA_SINK_BUFF_SIZE
+    #define UART_DMA_SINK_BUFF_SIZE 2048
+#endif
+
+// DMA interrupt used by the UART DMA sinks (0 or 1, i.e. DMA_IRQ_0 or DMA_IRQ_1).
+#ifndef UART_DMA_SINK_DMA_IRQ
+    #define UART_DMA_SINK_DMA_IRQ 0
+#endif
+
+// What to do with a message that doesn't fit into the ring buffer.
+typedef enum {
+    UART_DMA_SINK_DROP, // Drop the whole message and count it (never blocks).
+    UART_DMA_SINK_BLOCK // Wait until the DMA has sent enough of the buffer.
+} UART_DMA_SINK_FULL_POLICY_t;
+
+/*
+    UART DMA sink state. Messages are copied into the ring buffer and the caller returns
+    immediately. The DMA sends the queued bytes to the UART in the background, and its
+    completion interrupt starts the next transfer. Only a single logger may write to a sink.
+    The UART itself must be initialized separately (e.g. by stdio_init_all() or uart_init()).
+*/
+typedef struct {
+    uint8_t buff[UART_DMA_SINK_BUFF_SIZE] __attribute__((aligned(UART_DMA_SINK_BUFF_SIZE)));
+    uart_inst_t* uart;
+    spin_lock_t* lock;
+    volatile uint32_t head;         // Total number of bytes queued.
+    volatile uint32_t tail;         // Total number of bytes sent.
+    volatile uint32_t transfer_len; // Length of the running DMA transfer, 0 if idle.
+    volatile uint32_t dropped;      // Number of dropped messages.
+    UART_DMA_SINK_FULL_POLICY_t full_policy;
+    int dma_channel;
+} uart_dma_sink_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /**
+     * @brief Initializes a UART DMA sink.
+     *
+     * Claims a DMA channel and a spin lock, and installs the shared DMA interrupt handler.
+     * The sink should be statically allocated, as its buffer is aligned to its size.
+     *
+     * @param sink Sink state to initialize.
+     * @param uart UART instance to write to (e.g. uart0).
+     * @param full_policy What to do with messages that don't fit into the buffer.
+     * @return True on success, false if no DMA channel is available.
+     */
+    bool uart_dma_sink_init(uart_dma_sink_t* sink, uart_inst_t* uart, UART_DMA_SINK_FULL_POLICY_t full_policy);
+
+    /**
+     * @brief Waits for the queued bytes to be sent, and releases the DMA channel and spin lock.
+     *
+     * @param sink Initialized sink state.
+     */
+    void uart_dma_sink_deinit(uart_dma_sink_t* sink);
+
+    /**
+     * @brief Returns the log sink of a UART DMA sink, to be passed to the Logger constructor or logger_init_sink().
+     *
+     * @param sink Initialized sink state.
+     * @return Log sink writing to the UART DMA sink.
+     */
+    log_sink_t uart_dma_sink_get(uart_dma_sink_t* sink);
+
+    /**
+     * @brief Blocks until all queued bytes have been sent by the UART.
+     *
+     * Must not be called with interrupts disabled, as the DMA interrupt queues the remaining bytes.
+     *
+     * @param sink Initialized sink state.
+     */
+    void uart_dma_sink_flush(uart_dma_sink_t* sink);
+
+    /**
+     * @brief Returns the number of messages dropped because the buffer was full.
+     *
+     * Always 0 with the UART_DMA_SINK_BLOCK policy (except for messages larger than the buffer).
+     *
+     * @param sink Initialized sink state.
+     * @return Number of dropped messages.
+     */
+    uint32_t uart_dma_sink_get_dropped(const uart_dma_sink_t* sink);
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+/*
+    Pico Log - Non-blocking USB CDC sink.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+#include "pico/stdlib.h"
+#include "pico_log_lib/sink.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// Maximum time (in microseconds) a partial packet stays queued with USB_CDC_SINK_FLUSH_PACKET,
+// before it is flushed by the next message or usb_cdc_sink_poll().
+#ifndef USB_CDC_SINK_FLUSH_INTERVAL_US
+    #define USB_CDC_SINK_FLUSH_INTERVAL_US 10000
+#endif
+
+// When queued bytes are sent to the host.
+typedef enum {
+    USB_CDC_SINK_FLUSH_MESSAGE, // After every message (lowest latency).
+    USB_CDC_SINK_FLUSH_PACKET   // Only whole (64-byte) packets, partial packets are flushed after USB_CDC_SINK_FLUSH_INTERVAL_US.
+} USB_CDC_SINK_FLUSH_t;
+
+/*
+    USB CDC sink state. Messages are written directly into the TinyUSB transmit FIFO,
+    only if there is enough space for the whole message. Otherwise, the sink waits for
+    at most timeout_us, and then drops the message. Messages are also dropped if
+    the host has not opened the port. The TinyUSB device stack must be initialized and
+    serviced separately (e.g. by stdio_init_all() with pico_stdio_usb enabled).
+
+    TinyUSB is accessed with interrupts disabled, which keeps it from being serviced
+    (tud_task() from pico_stdio_usb's interrupt) at the same time on this core. The sink
+    must therefore log on the core that services TinyUSB: the core that called stdio_init_all(),
+    or the core that runs tud_task() when the application services TinyUSB itself.
+    Writing to the same interface through stdio (printf() with pico_stdio_usb) from
+    another core or an interrupt at the same time is not safe either.
+*/
+typedef struct {
+    uint8_t itf;
+    USB_CDC_SINK_FLUSH_t flush_mode;
+    uint32_t timeout_us;
+    uint32_t pending_since;     // Time of the oldest unflushed byte (time_us_32()).
+    bool pending;               // Bytes are waiting for a flush.
+    volatile uint32_t dropped;  // Number of dropped bytes.
+} usb_cdc_sink_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /**
+     * @brief Initializes a USB CDC sink.
+     *
+     * @param sink Sink state to initialize.
+     * @param itf CDC interface number (0 for the stdio_usb interface).
+     * @param flush_mode When queued bytes are sent to the host.
+     * @param timeout_us Maximum time to wait for transmit FIFO space, 0 to never wait.
+     */
+    void usb_cdc_sink_init(usb_cdc_sink_t* sink, uint8_t itf, USB_CDC_SINK_FLUSH_t flush_mode, uint32_t timeout_us);
+
+    /**
+     * @brief Returns the log sink of a USB CDC sink, to be passed to the Logger constructor or logger_init_sink().
+     *
+     * @param sink Initialized sink state.
+     * @return Log sink writing to the USB CDC sink.
+     */
+    log_sink_t usb_cdc_sink_get(usb_cdc_sink_t* sink);
+
+    /**
+     * @brief Flushes a partial packet that has been queued for longer than USB_CDC_SINK_FLUSH_INTERVAL_US.
+     *
+     * Only needed with USB_CDC_SINK_FLUSH_PACKET, e.g. from the main loop or an idle task.
+     * Must not be called concurrently with the logger using the sink.
+     *
+     * @param sink Initialized sink state.
+     */
+    void usb_cdc_sink_poll(usb_cdc_sink_t* sink);
+
+    /**
+     * @brief Sends all queued bytes to the host.
+     *
+     * Must not be called concurrently with the logger using the sink.
+     *
+     * @param sink Initialized sink state.
+     */
+    void usb_cdc_sink_flush(usb_cdc_sink_t* sink);
+
+    /**
+     * @brief Returns the number of bytes dropped because the transmit FIFO was full or the port was not open.
+     *
+     * @param sink Initialized sink state.
+     * @return Number of dropped bytes.
+     */
+    uint32_t usb_cdc_sink_get_dropped(const usb_cdc_sink_t* sink);
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,429 @@
+/*
+    Pico Log - Deferred argument capture.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "pico_log_lib/internal/arg_capture.h"
+#include "pico_log_lib/internal/style_tags.h"
+#include "pico_log_lib/internal/buff_write.h"
+#include <cstdio>
+#include <cstring>
+
+
+// Maximum length of a single conversion specification (e.g. "%-08.3lf").
+constexpr size_t FORMAT_SPEC_MAX_LEN = 16;
+
+// Marker length stored for null string arguments.
+constexpr uint8_t ARG_STR_NULL = 0xFF;
+
+static_assert(LOGGER_RECORD_MAX_STR_LEN < ARG_STR_NULL, "LOGGER_RECORD_MAX_STR_LEN must be less than 255");
+
+enum ARG_TYPE {
+    ARG_NONE,
+    ARG_INT,
+    ARG_LONG,
+    ARG_LLONG,
+    ARG_INTMAX,
+    ARG_SIZE,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_LDOUBLE,
+    ARG_STR,
+    ARG_PTR,
+    ARG_WRITEBACK
+};
+
+// Parsed printf conversion specification.
+struct format_spec {
+    ARG_TYPE type = ARG_NONE;
+    uint8_t num_stars = 0;
+    size_t len = 0;
+};
+typedef struct format_spec format_spec_t;
+
+
+// Parses the conversion specification at src_ptr (pointing to the '%' symbol).
+static format_spec_t parse_format_spec(const char* src_ptr) {
+    format_spec_t spec;
+    const char* spec_ptr = src_ptr + 1;
+    enum {LEN_NONE, LEN_L, LEN_LL, LEN_J, LEN_Z, LEN_T, LEN_BIG_L} len_mod = LEN_NONE;
+
+    while (*spec_ptr && strchr("-+ #0'", *spec_ptr)) {
+        spec_ptr++;
+    }
+
+    // Width and precision
+    for (uint32_t i = 0; i < 2; i++) {
+        if (*spec_ptr == '*') {
+            spec.num_stars++;
+            spec_ptr++;
+        } else {
+            while (*spec_ptr >= '0' && *spec_ptr <= '9') {
+                spec_ptr++;
+            }
+        }
+
+        if (i == 0 && *spec_ptr == '.') {
+            spec_ptr++;
+        } else {
+            break;
+        }
+    }
+
+    switch (*spec_ptr) {
+        case 'h':
+            spec_ptr += (spec_ptr[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            len_mod = (spec_ptr[1] == 'l') ? LEN_LL : LEN_L;
+            spec_ptr += (len_mod == LEN_LL) ? 2 : 1;
+            break;
+        case 'j': len_mod = LEN_J; spec_ptr++; break;
+        case 'z': len_mod = LEN_Z; spec_ptr++; break;
+        case 't': len_mod = LEN_T; spec_ptr++; break;
+        case 'L': len_mod = LEN_BIG_L; spec_ptr++; break;
+    }
+
+    switch (*spec_ptr) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            switch (len_mod) {
+                case LEN_L:  spec.type = ARG_LONG; break;
+                case LEN_LL: spec.type = ARG_LLONG; break;
+                case LEN_J:  spec.type = ARG_INTMAX; break;
+                case LEN_Z:  spec.type = ARG_SIZE; break;
+                case LEN_T:  spec.type = ARG_PTRDIFF; break;
+                default:     spec.type = ARG_INT; break;
+            }
+            break;
+        case 'c':
+            spec.type = ARG_INT;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            spec.type = (len_mod == LEN_BIG_L) ? ARG_LDOUBLE : ARG_DOUBLE;
+            break;
+        case 's':
+            spec.type = (len_mod == LEN_L) ? ARG_PTR : ARG_STR;
+            break;
+        case 'p':
+            spec.type = ARG_PTR;
+            break;
+        case 'n':
+            spec.type = ARG_WRITEBACK;
+            break;
+        default:
+            // Unknown conversion, consumes no arguments.
+            spec.num_stars = 0;
+            spec.len = (*spec_ptr) ? (spec_ptr - src_ptr + 1) : (spec_ptr - src_ptr);
+            return spec;
+    }
+
+    spec.len = spec_ptr - src_ptr + 1;
+    return spec;
+}
+
+// Returns the number of bytes a captured argument of the given type occupies.
+static size_t arg_type_size(const ARG_TYPE type) {
+    switch (type) {
+        case ARG_INT:       return sizeof(int);
+        case ARG_LONG:      return sizeof(long);
+        case ARG_LLONG:     return sizeof(long long);
+        case ARG_INTMAX:    return sizeof(intmax_t);
+        case ARG_SIZE:      return sizeof(size_t);
+        case ARG_PTRDIFF:   return sizeof(ptrdiff_t);
+        case ARG_DOUBLE:    return sizeof(double);
+        case ARG_LDOUBLE:   return sizeof(long double);
+        case ARG_PTR:       return sizeof(void*);
+        default:            return 0;
+    }
+}
+
+
+#define CAPTURE_ARG(type)                              \
+    {                                                  \
+        type value = va_arg(args, type);               \
+        memcpy(buff + buff_pos, &value, sizeof(type)); \
+    }                                                  \
+    break;
+
+size_t log_args_capture(const char* format, va_list args, uint8_t* buff, const size_t buff_size, const bool skip_style_tags) {
+    size_t tag_len, buff_pos = 0;
+    format_spec_t spec;
+
+    while (*format) {
+        if (*format != '%') {
+            format++;
+            continue;
+        }
+
+        if (format[1] == '%') {
+            format += 2;
+            continue;
+        }
+
+        if (skip_style_tags && (tag_len = style_tag_len(format)) > 0) {
+            format += tag_len;
+            continue;
+        }
+
+        spec = parse_format_spec(format);
+        format += spec.len;
+
+        for (uint32_t i = 0; i < spec.num_stars; i++) {
+            if (buff_pos + sizeof(int) > buff_size) {
+                return buff_pos;
+            }
+
+            int value = va_arg(args, int);
+            memcpy(buff + buff_pos, &value, sizeof(int));
+            buff_pos += sizeof(int);
+        }
+
+        if (spec.type == ARG_STR) {
+            const char* str = va_arg(args, const char*);
+            const size_t str_len = (str == nullptr) ? 0 : strnlen(str, LOGGER_RECORD_MAX_STR_LEN);
+
+            if (buff_pos + 1 + str_len > buff_size) {
+                return buff_pos;
+            }
+
+            buff[buff_pos++] = (str == nullptr) ? ARG_STR_NULL : str_len;
+            if (str_len > 0) {
+                memcpy(buff + buff_pos, str, str_len);
+                buff_pos += str_len;
+            }
+            continue;
+        }
+
+        if (buff_pos + arg_type_size(spec.type) > buff_size) {
+            return buff_pos;
+        }
+
+        switch (spec.type) {
+            case ARG_INT:       CAPTURE_ARG(int);
+            case ARG_LONG:      CAPTURE_ARG(long);
+            case ARG_LLONG:     CAPTURE_ARG(long long);
+            case ARG_INTMAX:    CAPTURE_ARG(intmax_t);
+            case ARG_SIZE:      CAPTURE_ARG(size_t);
+            case ARG_PTRDIFF:   CAPTURE_ARG(ptrdiff_t);
+            case ARG_DOUBLE:    CAPTURE_ARG(double);
+            case ARG_LDOUBLE:   CAPTURE_ARG(long double);
+            case ARG_PTR:       CAPTURE_ARG(void*);
+            case ARG_WRITEBACK: (void) va_arg(args, void*); break;
+            default:            break;
+        }
+
+        buff_pos += arg_type_size(spec.type);
+    }
+
+    return buff_pos;
+}
+
+
+// Reads arguments captured by log_args_capture().
+struct captured_arg_reader {
+    const uint8_t* args;
+    size_t args_len;
+    size_t args_pos = 0;
+
+    template <typename T>
+    bool read(T& value) {
+        if (this->args_pos + sizeof(T) > this->args_len) {
+            return false;
+        }
+
+        memcpy(&value, this->args + this->args_pos, sizeof(T));
+        this->args_pos += sizeof(T);
+        return true;
+    }
+
+    // Copies a string argument into str_buff (LOGGER_RECORD_MAX_STR_LEN + 1 characters).
+    bool read_str(const char*& str, char* str_buff) {
+        if (this->args_pos + 1 > this->args_len) {
+            return false;
+        }
+
+        const uint8_t str_len = this->args[this->args_pos];
+        if (str_len == ARG_STR_NULL) {
+            this->args_pos++;
+            str = "(null)";
+            return true;
+        }
+
+        if (this->args_pos + 1 + str_len > this->args_len) {
+            return false;
+        }
+
+        memcpy(str_buff, this->args + this->args_pos + 1, str_len);
+        str_buff[str_len] = '\0';
+        this->args_pos += 1 + str_len;
+        str = str_buff;
+        return true;
+    }
+
+    void skip_writeback() {}
+};
+
+// Reads arguments from a va_list.
+struct va_arg_reader {
+    va_list args;
+
+    template <typename T>
+    bool read(T& value) {
+        value = va_arg(this->args, T);
+        return true;
+    }
+
+    bool read_str(const char*& str, char* str_buff) {
+        (void) str_buff;
+        str = va_arg(this->args, const char*);
+        str = (str != nullptr) ? str : "(null)";
+        return true;
+    }
+
+    void skip_writeback() {
+        (void) va_arg(this->args, void*);
+    }
+};
+
+
+#define SPEC_SNPRINTF(value)                                                                    \
+    switch (spec.num_stars) {                                                                   \
+        case 0:  str_len = snprintf(out, out_size, spec_str, value); break;                     \
+        case 1:  str_len = snprintf(out, out_size, spec_str, stars[0], value); break;           \
+        default: str_len = snprintf(out, out_size, spec_str, stars[0], stars[1], value); break; \
+    }
+
+#define FORMAT_ARG(type)                \
+    {                                   \
+        type value;                     \
+        if (!reader.read(value)) {      \
+            goto exit_loop;             \
+        }                               \
+        SPEC_SNPRINTF(value);           \
+    }                                   \
+    break;
+
+// Formats a message with printf conversion specifications, one specification at a time.
+// Style tags are handled according to style_tags.
+template <typename Reader>
+static size_t format_args(char* buff, const size_t buff_size, const char* format, Reader& reader, const STYLE_TAG_MODE style_tags) {
+    size_t buff_pos = 0;
+    char spec_str[FORMAT_SPEC_MAX_LEN + 1];
+    char str_arg[LOGGER_RECORD_MAX_STR_LEN + 1];
+    const char* str_value;
+    int stars[2], str_len;
+    format_spec_t spec;
+    style_tag_t tag;
+
+    if (buff_size == 0) {
+        return 0;
+    }
+
+    while (*format && buff_pos < buff_size - 1) {
+        if (*format != '%' || format[1] == '%') {
+            buff[buff_pos++] = *format;
+            format += (*format == '%') ? 2 : 1;
+            continue;
+        }
+
+        if (style_tags != STYLE_TAGS_KEEP && (tag = style_tag_parse(format)).len > 0) {
+            if (style_tags == STYLE_TAGS_TRANSLATE && tag.style != nullptr) {
+                buff_concat(buff, buff_size, buff_pos, tag.style);
+            } else if (style_tags == STYLE_TAGS_TRANSLATE) {
+                buff_write_color(buff, buff_size, buff_pos, tag.color_code);
+            }
+
+            format += tag.len;
+            continue;
+        }
+
+        spec = parse_format_spec(format);
+
+        // Unknown or oversized specifications are copied as literal text.
+        if (spec.type == ARG_NONE || spec.len > FORMAT_SPEC_MAX_LEN) {
+            for (size_t i = 0; i < spec.len && buff_pos < buff_size - 1; i++) {
+                buff[buff_pos++] = format[i];
+            }
+
+            format += spec.len;
+            continue;
+        }
+
+        memcpy(spec_str, format, spec.len);
+        spec_str[spec.len] = '\0';
+        format += spec.len;
+
+        // Stop at the first argument that is not available.
+        for (uint32_t i = 0; i < spec.num_stars; i++) {
+            if (!reader.read(stars[i])) {
+                goto exit_loop;
+            }
+        }
+
+        char* out = buff + buff_pos;
+        const size_t out_size = buff_size - buff_pos;
+        str_len = 0;
+
+        switch (spec.type) {
+            case ARG_INT:     FORMAT_ARG(int);
+            case ARG_LONG:    FORMAT_ARG(long);
+            case ARG_LLONG:   FORMAT_ARG(long long);
+            case ARG_INTMAX:  FORMAT_ARG(intmax_t);
+            case ARG_SIZE:    FORMAT_ARG(size_t);
+            case ARG_PTRDIFF: FORMAT_ARG(ptrdiff_t);
+            case ARG_DOUBLE:  FORMAT_ARG(double);
+            case ARG_LDOUBLE: FORMAT_ARG(long double);
+            case ARG_PTR:     FORMAT_ARG(void*);
+            case ARG_STR:
+                if (!reader.read_str(str_value, str_arg)) {
+                    goto exit_loop;
+                }
+
+                SPEC_SNPRINTF(str_value);
+                break;
+            case ARG_WRITEBACK:
+                reader.skip_writeback();
+                break;
+            default:
+                break;
+        }
+
+        if (str_len > 0) {
+            buff_pos += ((size_t) str_len < out_size) ? str_len : out_size - 1;
+        }
+    }
+
+    exit_loop:
+    buff[buff_pos] = '\0';
+    return buff_pos;
+}
+
+size_t log_args_vsnprintf(char* buff, const size_t buff_size, const char* format, const uint8_t* args, const size_t args_len, 
+                          const STYLE_TAG_MODE style_tags) {
+    captured_arg_reader reader = {args, args_len};
+    return format_args(buff, buff_size, format, reader, style_tags);
+}
+
+size_t log_vsnprintf_styled(char* buff, const size_t buff_size, const char* format, va_list args, const STYLE_TAG_MODE style_tags) {
+    va_arg_reader reader;
+    va_copy(reader.args, args);
+    const size_t str_len = format_args(buff, buff_size, format, reader, style_tags);
+    va_end(reader.args);
+    return str_len;
+}
\ No newline at end of file
@@ -37,6 +37,21 @@ logger_handle_t logger_init(stdio_driver_t* stdio_driver, logger_options_t* opti
     #endif
 }
 
+logger_handle_t logger_init_sink(const log_sink_t* sink, logger_options_t* options) {
+    assert(sink != nullptr);
+
+    #ifdef PICO_LOG_FREERTOS
+    void* memory = pvPortMalloc(sizeof(Logger));
+    if (memory == nullptr) {
+        return nullptr;
+    }
+
+    return static_cast<logger_handle_t>(new (memory) Logger(*sink, options));
+    #else
+    return static_cast<logger_handle_t>(new Logger(*sink, options));
+    #endif
+}
+
 void logger_destroy(logger_handle_t logger) {
     if (logger != nullptr) {
         #ifdef PICO_LOG_FREERTOS
@@ -55,11 +70,63 @@ bool logger_init_mutex(logger_handle_t logger) {
     return static_cast<Logger*>(logger)->init_mutex();
 }
 
+bool logger_add_sink(logger_handle_t logger, const log_sink_t* sink, const LOG_LEVEL_t level, const bool ansi_styling) {
+    assert(logger != nullptr && sink != nullptr);
+    return static_cast<Logger*>(logger)->add_sink(*sink, level, ansi_styling);
+}
+
+uint8_t logger_module_id(const char* module) {
+    assert(module != nullptr);
+    return log_module_id(module);
+}
+
+void logger_set_module_level(logger_handle_t logger, const uint8_t module, const LOG_LEVEL_t level) {
+    assert(logger != nullptr);
+    static_cast<Logger*>(logger)->set_module_level(module, level);
+}
+
+void logger_clear_module_level(logger_handle_t logger, const uint8_t module) {
+    assert(logger != nullptr);
+    static_cast<Logger*>(logger)->clear_module_level(module);
+}
+
 bool logger_reparse_format(logger_handle_t logger) {
     assert(logger != nullptr);
     return static_cast<Logger*>(logger)->reparse_format();
 }
 
+size_t logger_drain(logger_handle_t logger) {
+    assert(logger != nullptr);
+    return static_cast<Logger*>(logger)->drain();
+}
+
+uint32_t logger_get_dropped_records(logger_handle_t logger) {
+    assert(logger != nullptr);
+    return static_cast<Logger*>(logger)->get_dropped_records();
+}
+
+uint32_t logger_get_skipped_messages(logger_handle_t logger) {
+    assert(logger != nullptr);
+    return static_cast<Logger*>(logger)->get_skipped_messages();
+}
+
+uint32_t logger_get_truncated_messages(logger_handle_t logger) {
+    assert(logger != nullptr);
+    return static_cast<Logger*>(logger)->get_truncated_messages();
+}
+
+#ifdef PICO_LOG_FREERTOS
+bool logger_start_log_task(logger_handle_t logger, const UBaseType_t priority, const configSTACK_DEPTH_TYPE stack_depth) {
+    assert(logger != nullptr);
+    return static_cast<Logger*>(logger)->start_log_task(priority, stack_depth);
+}
+#else
+bool logger_launch_core1_drain(logger_handle_t logger) {
+    assert(logger != nullptr);
+    return static_cast<Logger*>(logger)->launch_core1_drain();
+}
+#endif
+
 void logger_log(logger_handle_t logger, const char* func, const char* file, const uint16_t line, 
                 const LOG_LEVEL_t level, const char* message, ...) {
     assert(logger != nullptr);
@@ -74,3 +141,42 @@ void logger_vlog(logger_handle_t logger, const LOG_LEVEL_t level, const char* me
     assert(logger != nullptr);
     static_cast<Logger*>(logger)->vlog(level, message, args, func, file, line);
 }
+
+void logger_log_from_isr(logger_handle_t logger, const char* func, const char* file, const uint16_t line, 
+                         const LOG_LEVEL_t level, const char* message, ...) {
+    assert(logger != nullptr);
+    va_list args;
+    va_start(args, message);
+    static_cast<Logger*>(logger)->vlog_from_isr(level, message, args, func, file, line);
+    va_end(args);
+}
+
+void logger_log_module(logger_handle_t logger, const uint8_t module, const char* func, const char* file, const uint16_t line, 
+                       const LOG_LEVEL_t level, const char* message, ...) {
+    assert(logger != nullptr);
+    Logger* logger_obj = static_cast<Logger*>(logger);
+
+    // Checked before va_start(), messages are usually filtered out.
+    if (!logger_obj->is_enabled(level, module)) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, message);
+    logger_obj->vlog_module(module, level, message, args, func, file, line);
+    va_end(args);
+}
+
+void logger_log_site(logger_handle_t logger, const log_callsite_t* site, const char* message, ...) {
+    assert(logger != nullptr && site != nullptr);
+    Logger* logger_obj = static_cast<Logger*>(logger);
+
+    if (!logger_obj->is_enabled(site)) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, message);
+    logger_obj->vlog_site(site, message, args);
+    va_end(args);
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+/*
+    Pico Log - Log call-site registry.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "pico_log_lib/callsites.h"
+#include <cstring>
+
+
+// Call-site table bounds, provided by the linker. Weak, as the section
+// does not exist if no call sites are registered.
+extern const log_callsite_t* const __start_pico_log_callsites[] __attribute__((weak));
+extern const log_callsite_t* const __stop_pico_log_callsites[] __attribute__((weak));
+
+
+// Returns the part of a path after the last '/' or '\'.
+static const char* path_base_name(const char* path) {
+    const char* base_ptr = path;
+
+    for (const char* src_ptr = path; *src_ptr; src_ptr++) {
+        if (*src_ptr == '/' || *src_ptr == '\\') {
+            base_ptr = src_ptr + 1;
+        }
+    }
+
+    return base_ptr;
+}
+
+
+size_t log_callsite_count(void) {
+    if (__start_pico_log_callsites == nullptr) {
+        return 0;
+    }
+
+    return __stop_pico_log_callsites - __start_pico_log_callsites;
+}
+
+const log_callsite_t* log_callsite_get(const size_t index) {
+    return (index < log_callsite_count()) ? __start_pico_log_callsites[index] : nullptr;
+}
+
+size_t log_callsite_set(const char* file, const uint16_t line, const LOG_CALLSITE_STATE_t state) {
+    const char* file_name = (file != nullptr) ? path_base_name(file) : nullptr;
+    const size_t num_callsites = log_callsite_count();
+    size_t num_changed = 0;
+
+    for (size_t i = 0; i < num_callsites; i++) {
+        const log_callsite_t* site = __start_pico_log_callsites[i];
+
+        if ((line != 0 && site->line != line) || (file_name != nullptr && strcmp(path_base_name(site->file), file_name) != 0)) {
+            continue;
+        }
+
+        *site->state = state;
+        num_changed++;
+    }
+
+    return num_changed;
+}
\ No newline at end of file
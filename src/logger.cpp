@@ -20,23 +20,159 @@
 */
 
 #include "pico_log_lib/logger.h"
+#include "pico_log_lib/internal/buff_write.h"
+#include <array>
+#include <cctype>
 #include <cstdio>
 #include <cstring>
 
+#ifndef PICO_LOG_FREERTOS
+#include "pico/multicore.h"
+#endif
+
+
+#ifndef PICO_LOG_FREERTOS
+Logger* Logger::core1_drain_logger = nullptr;
+#endif
+
+
+// FNV-1a hash of a byte buffer, continued from hash.
+static uint32_t hash_bytes(uint32_t hash, const void* data, const size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ static_cast<const uint8_t*>(data)[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+// Hashes the raw values of the arguments of a printf-style message (strings by value).
+// The arguments are captured in full, like a deferred record, on every call with suppress_repeats.
+static uint32_t hash_va_args(const char* format, va_list args, const bool skip_style_tags) {
+    uint8_t args_buff[LOGGER_RECORD_ARGS_SIZE];
+    va_list hash_args;
+    va_copy(hash_args, args);
+    const size_t args_len = log_args_capture(format, hash_args, args_buff, LOGGER_RECORD_ARGS_SIZE, skip_style_tags);
+    va_end(hash_args);
+    return hash_bytes(2166136261u, args_buff, args_len);
+}
+
+// Hashes the arguments of a log_typed() message (strings by value).
+static uint32_t hash_typed_args(const log_typed_arg_t* args, const size_t num_args) {
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < num_args; i++) {
+        const uint8_t format[] = {args[i].type, args[i].digits, args[i].frac_bits};
+        hash = hash_bytes(hash, format, sizeof(format));
+
+        if (args[i].type == TYPED_ARG_STR && args[i].str != nullptr) {
+            hash = hash_bytes(hash, args[i].str, strlen(args[i].str));
+        } else {
+            hash = hash_bytes(hash, &args[i].u64, sizeof(args[i].u64));
+        }
+    }
+
+    return hash;
+}
+
+
+// Formats a printf-style message into buff (always null-terminated), with style tags handled according to style_tags.
+// Returns the number of characters written.
+static size_t format_text(char* buff, const size_t buff_size, const char* format, va_list args, const STYLE_TAG_MODE style_tags) {
+    va_list text_args;
+    va_copy(text_args, args);
+    int len;
+
+    if (style_tags != STYLE_TAGS_KEEP) {
+        len = log_vsnprintf_styled(buff, buff_size, format, text_args, style_tags);
+    } else {
+        buff[0] = '\0';
+        len = vsnprintf(buff, buff_size, format, text_args);
+
+        // Keep whatever was written if vsnprintf() failed on an invalid conversion.
+        if (len < 0) {
+            len = strnlen(buff, buff_size - 1);
+        }
+    }
+
+    va_end(text_args);
+    return ((size_t) len < buff_size) ? len : buff_size - 1;
+}
+
+// Marker ending messages truncated when queued as text.
+static constexpr char TEXT_TRUNCATED[] = "[...]";
+
+// Fits a message formatted into LOGGER_RECORD_TEXT_SIZE + 1 characters into LOGGER_RECORD_TEXT_SIZE - 1 characters.
+// A message that doesn't fit is cut before any ANSI escape code it would split, reset if it is styled,
+// and ends with TEXT_TRUNCATED. Returns the length of the message.
+static size_t fit_text(char* text, const size_t len) {
+    if (len < LOGGER_RECORD_TEXT_SIZE) {
+        return len;
+    }
+
+    // Space for the reset is only kept in styled messages.
+    const size_t reset_len = strlen(ANSI_RESET);
+    size_t cut_len = LOGGER_RECORD_TEXT_SIZE - 1 - (sizeof(TEXT_TRUNCATED) - 1);
+    cut_len -= (memchr(text, '\033', cut_len) != nullptr) ? reset_len : 0;
+    bool styled = false;
+
+    for (size_t i = 0; i < cut_len; i++) {
+        if (text[i] != '\033') {
+            continue;
+        }
+
+        // Escape codes end with a letter.
+        size_t end = i + 1;
+
+        while (end < cut_len && !isalpha((unsigned char) text[end])) {
+            end++;
+        }
+
+        if (end == cut_len) {
+            cut_len = i;
+            break;
+        }
+
+        styled = true;
+        i = end;
+    }
+
+    if (styled) {
+        memcpy(text + cut_len, ANSI_RESET, reset_len);
+        cut_len += reset_len;
+    }
+
+    memcpy(text + cut_len, TEXT_TRUNCATED, sizeof(TEXT_TRUNCATED));
+    return cut_len + sizeof(TEXT_TRUNCATED) - 1;
+}
+
 
 /* ---- PUBLIC ---- */
-Logger::Logger(stdio_driver_t* stdio_driver, logger_options_t* options) {
-    assert(stdio_driver != nullptr && options != nullptr);
+Logger::Logger(stdio_driver_t* stdio_driver, logger_options_t* options) 
+    : Logger(log_sink_t {stdio_driver, stdio_out_chars, nullptr}, options) {
+    assert(stdio_driver != nullptr);
+}
+
+Logger::Logger(const log_sink_t& sink, logger_options_t* options) {
+    assert(sink.out_chars != nullptr && options != nullptr);
     
-    this->stdio_driver = stdio_driver;
+    this->sinks[0] = {sink, LOG_LVL_DEBUG, false};
     this->options = options;
+    this->record_lock = spin_lock_instance(spin_lock_claim_unused(true));
+    memset(this->module_levels, MODULE_LEVEL_GLOBAL, sizeof(this->module_levels));
 
+    #ifndef PICO_LOG_STATIC_FORMAT
     this->clear_format_tokens();
     this->msg_format_tokenize();
+    #endif
 }
 
 Logger::~Logger() {
     #ifdef PICO_LOG_FREERTOS
+    if (this->log_task != nullptr) {
+        vTaskDelete(this->log_task);
+        this->log_task = nullptr;
+    }
+
     if (this->log_mutex != nullptr) {
         // Wait for a maximum of 500 ticks to take the mutex.
         (void) xSemaphoreTake(this->log_mutex, 500);
@@ -44,6 +180,8 @@ Logger::~Logger() {
         this->log_mutex = nullptr;
     }
     #endif
+
+    spin_lock_unclaim(spin_lock_get_num(this->record_lock));
 }
 
 bool Logger::init_mutex() {
@@ -71,25 +209,167 @@ void Logger::log(const char* func, const char* file, const uint16_t line, const
 
 void Logger::vlog(const LOG_LEVEL_t level, const char* message, va_list args, 
                   const char* func, const char* file, const uint16_t line) {
-    assert(func != nullptr && file != nullptr && message != nullptr);
-    
-    if (this->options->logging_level <= level && this->take_log_mutex()) {
-        const bool proc_style_tags = this->options->ansi_styling && this->options->process_style_tags;
-        const char* message_ptr = proc_style_tags ? this->output_buff : message;
+    if (this->is_enabled(level)) {
+        this->vlog_msg(level, message, nullptr, args, func, file, line, this->style_tags_enabled());
+    }
+}
 
-        if (proc_style_tags) {
-            msg_process_style(message, this->output_buff, LOGGER_BUFF_SIZE);
+void Logger::log(const char* func, const char* file, const uint16_t line, const LOG_LEVEL_t level, const styled_message_t message, ...) {
+    va_list args;
+    va_start(args, message);
+    this->vlog(level, message, args, func, file, line);
+    va_end(args);
+}
+
+void Logger::vlog(const LOG_LEVEL_t level, const styled_message_t message, va_list args, 
+                  const char* func, const char* file, const uint16_t line) {
+    // Style tags are already translated, only the right variant has to be picked.
+    if (this->is_enabled(level)) {
+        const bool styled = this->style_tags_enabled();
+        this->vlog_msg(level, styled ? message.styled : message.plain, message.plain, args, func, file, line, false);
+    }
+}
+
+void Logger::log_module(const uint8_t module, const char* func, const char* file, const uint16_t line, 
+                        const LOG_LEVEL_t level, const char* message, ...) {
+    // Checked before va_start(), messages are usually filtered out.
+    if (!this->is_enabled(level, module)) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, message);
+    this->vlog_msg(level, message, nullptr, args, func, file, line, this->style_tags_enabled());
+    va_end(args);
+}
+
+void Logger::log_module(const uint8_t module, const char* func, const char* file, const uint16_t line, 
+                        const LOG_LEVEL_t level, const styled_message_t message, ...) {
+    if (!this->is_enabled(level, module)) {
+        return;
+    }
+
+    const bool styled = this->style_tags_enabled();
+    va_list args;
+    va_start(args, message);
+    this->vlog_msg(level, styled ? message.styled : message.plain, message.plain, args, func, file, line, false);
+    va_end(args);
+}
+
+void Logger::vlog_module(const uint8_t module, const LOG_LEVEL_t level, const char* message, va_list args, 
+                         const char* func, const char* file, const uint16_t line) {
+    if (this->is_enabled(level, module)) {
+        this->vlog_msg(level, message, nullptr, args, func, file, line, this->style_tags_enabled());
+    }
+}
+
+void Logger::log_site(const log_callsite_t* site, const uint8_t module, const char* message, ...) {
+    if (!this->is_enabled(site, module)) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, message);
+    this->vlog_msg((LOG_LEVEL_t) site->level, message, nullptr, args, site->func, site->file, site->line, this->style_tags_enabled());
+    va_end(args);
+}
+
+void Logger::log_site(const log_callsite_t* site, const uint8_t module, const styled_message_t message, ...) {
+    if (!this->is_enabled(site, module)) {
+        return;
+    }
+
+    const bool styled = this->style_tags_enabled();
+    va_list args;
+    va_start(args, message);
+    this->vlog_msg((LOG_LEVEL_t) site->level, styled ? message.styled : message.plain, message.plain, args, site->func, site->file, site->line, false);
+    va_end(args);
+}
+
+void Logger::vlog_site(const log_callsite_t* site, const char* message, va_list args) {
+    if (this->is_enabled(site)) {
+        this->vlog_msg((LOG_LEVEL_t) site->level, message, nullptr, args, site->func, site->file, site->line, this->style_tags_enabled());
+    }
+}
+
+#ifdef PICO_LOG_TOKENIZED
+void Logger::log_token(const uint8_t module, const log_token_t* token, ...) {
+    if (!this->is_enabled((LOG_LEVEL_t) token->level, module)) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, token);
+    this->vlog_token(token, args);
+    va_end(args);
+}
+#endif
+
+void Logger::log_from_isr(const char* func, const char* file, const uint16_t line, 
+                          const LOG_LEVEL_t level, const char* message, ...) {
+    va_list args;
+    va_start(args, message);
+    this->vlog_from_isr(level, message, args, func, file, line);
+    va_end(args);
+}
+
+void Logger::vlog_from_isr(const LOG_LEVEL_t level, const char* message, va_list args, 
+                           const char* func, const char* file, const uint16_t line) {
+    if (this->is_enabled(level)) {
+        this->vlog_isr(level, message, nullptr, args, func, file, line, this->style_tags_enabled());
+    }
+}
+
+void Logger::log_from_isr(const char* func, const char* file, const uint16_t line, 
+                          const LOG_LEVEL_t level, const styled_message_t message, ...) {
+    if (!this->is_enabled(level)) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, message);
+    this->vlog_isr(level, this->style_tags_enabled() ? message.styled : message.plain, message.plain, args, func, file, line, false);
+    va_end(args);
+}
+
+void Logger::set_module_level(const uint8_t module, const LOG_LEVEL_t level) {
+    this->module_levels[module & (LOGGER_MODULE_TABLE_SIZE - 1)] = level;
+}
+
+void Logger::set_module_level(const char* module, const LOG_LEVEL_t level) {
+    this->set_module_level(log_module_id(module), level);
+}
+
+void Logger::clear_module_level(const uint8_t module) {
+    this->module_levels[module & (LOGGER_MODULE_TABLE_SIZE - 1)] = MODULE_LEVEL_GLOBAL;
+}
+
+void Logger::clear_module_level(const char* module) {
+    this->clear_module_level(log_module_id(module));
+}
+
+bool Logger::add_sink(const log_sink_t& sink, const LOG_LEVEL_t level, const bool ansi_styling) {
+    assert(sink.out_chars != nullptr);
+    bool added = false;
+
+    if (this->take_log_mutex()) {
+        if (this->num_sinks < LOGGER_MAX_SINKS) {
+            this->sinks[this->num_sinks++] = {sink, level, ansi_styling};
+            this->num_styled_sinks += ansi_styling ? 1 : 0;
+            added = true;
         }
 
-        vsnprintf(this->tmp_buff, LOGGER_BUFF_SIZE, message_ptr, args);
-        size_t msg_len = msg_process_format(this->output_buff, LOGGER_BUFF_SIZE, this->tmp_buff, level, func, file, line);
-        
-        this->stdio_driver->out_chars(this->output_buff, msg_len);
         this->release_log_mutex();
     }
+
+    return added;
 }
 
 bool Logger::reparse_format() {
+    #ifdef PICO_LOG_STATIC_FORMAT
+    // The log format is parsed at compile-time.
+    return true;
+    #else
     if (this->take_log_mutex()) {
         this->clear_format_tokens();
         this->msg_format_tokenize();
@@ -98,10 +378,207 @@ bool Logger::reparse_format() {
     }
 
     return false;
+    #endif
+}
+
+size_t Logger::drain() {
+    size_t num_records = 0;
+
+    if (this->take_log_mutex()) {
+        num_records = this->record_output_all();
+        this->release_log_mutex();
+    }
+
+    return num_records;
 }
 
+uint32_t Logger::get_dropped_records() {
+    return this->records_dropped;
+}
+
+uint32_t Logger::get_skipped_messages() {
+    return this->messages_skipped;
+}
+
+uint32_t Logger::get_truncated_messages() {
+    return this->messages_truncated;
+}
+
+#ifdef PICO_LOG_FREERTOS
+bool Logger::start_log_task(const UBaseType_t priority, const configSTACK_DEPTH_TYPE stack_depth) {
+    if (this->log_task != nullptr || !this->init_mutex()) {
+        return false;
+    }
+
+    if (xTaskCreate(log_task_entry, "Logger", stack_depth, this, priority, &this->log_task) != pdPASS) {
+        this->log_task = nullptr;
+        return false;
+    }
+
+    this->drain_engine_active = true;
+    return true;
+}
+#else
+bool Logger::launch_core1_drain() {
+    if (core1_drain_logger != nullptr || !this->init_mutex()) {
+        return false;
+    }
+
+    core1_drain_logger = this;
+    this->drain_engine_active = true;
+    multicore_launch_core1(core1_drain_entry);
+    return true;
+}
+#endif
+
 
 /* ---- PRIVATE ---- */
+// Sink output function of stdio drivers.
+void Logger::stdio_out_chars(void* ctx, const char* buf, size_t len) {
+    static_cast<stdio_driver_t*>(ctx)->out_chars(buf, len);
+}
+
+inline void Logger::vlog_msg(const LOG_LEVEL_t level, const char* message, const char* plain_message, va_list args, 
+                             const char* func, const char* file, const uint16_t line, const bool proc_style_tags) {
+    assert(func != nullptr && file != nullptr && message != nullptr);
+
+    if (this->options->suppress_repeats && this->repeat_check(level, message, hash_va_args(message, args, proc_style_tags), func, file, line)) {
+        return;
+    }
+
+    const log_context_t ctx = this->make_context(level, func, file, line);
+
+    // Deferred mode: only capture the arguments, formatting is done by drain().
+    if (this->options->deferred_logging || this->drain_engine_active) {
+        this->record_push(ctx, message, plain_message, args, proc_style_tags, false);
+        return;
+    }
+
+    // By default, don't wait for another core or task that is currently writing to the sinks.
+    // The message is queued instead, and is output by the current mutex holder.
+    switch (this->lock_message()) {
+        case LOCK_QUEUE:
+            // Formatted by the caller: the message and its arguments may not outlive the call.
+            this->record_push_text(ctx, message, plain_message, args, proc_style_tags);
+
+            if (this->try_take_log_mutex()) {
+                this->release_log_mutex_drain();
+            }
+            return;
+        case LOCK_SKIPPED:
+            return;
+        case LOCK_TAKEN:
+            break;
+    }
+
+    // Output any queued records first to preserve ordering.
+    this->record_output_all();
+
+    log_message_t msg = {MESSAGE_VA_LIST, message, plain_message, proc_style_tags};
+    va_list msg_args;
+    va_copy(msg_args, args);
+    msg.va_args = &msg_args;
+
+    this->msg_output(ctx, msg);
+    va_end(msg_args);
+    this->release_log_mutex_drain();
+}
+
+void Logger::vlog_typed(const LOG_LEVEL_t level, const char* message, const char* plain_message, 
+                        const log_typed_arg_t* args, const size_t num_args, 
+                        const char* func, const char* file, const uint16_t line, const bool proc_style_tags) {
+    assert(func != nullptr && file != nullptr && message != nullptr);
+
+    if (this->options->suppress_repeats && this->repeat_check(level, message, hash_typed_args(args, num_args), func, file, line)) {
+        return;
+    }
+
+    const log_context_t ctx = this->make_context(level, func, file, line);
+
+    // Deferred mode: the arguments may not outlive the call, the message is queued as text.
+    if (this->options->deferred_logging || this->drain_engine_active) {
+        this->record_push_text(ctx, message, plain_message, args, num_args, proc_style_tags);
+        return;
+    }
+
+    switch (this->lock_message()) {
+        case LOCK_QUEUE:
+            this->record_push_text(ctx, message, plain_message, args, num_args, proc_style_tags);
+
+            if (this->try_take_log_mutex()) {
+                this->release_log_mutex_drain();
+            }
+            return;
+        case LOCK_SKIPPED:
+            return;
+        case LOCK_TAKEN:
+            break;
+    }
+
+    this->record_output_all();
+
+    log_message_t msg = {MESSAGE_TYPED, message, plain_message, proc_style_tags};
+    msg.typed_args = args;
+    msg.num_typed_args = num_args;
+
+    this->msg_output(ctx, msg);
+    this->release_log_mutex_drain();
+}
+
+// Queues a message from an interrupt handler. The log mutex is never taken, the record is output
+// from thread context by the next drain() or log call (or by the drain engine, which is notified).
+inline void Logger::vlog_isr(const LOG_LEVEL_t level, const char* message, const char* plain_message, va_list args, 
+                             const char* func, const char* file, const uint16_t line, const bool proc_style_tags) {
+    assert(func != nullptr && file != nullptr && message != nullptr);
+
+    // The interrupted task's name is meaningless here.
+    const log_context_t ctx = {func, file, line, level, to_ms_since_boot(get_absolute_time()), (uint8_t) get_core_num(), "ISR"};
+    this->record_push(ctx, message, plain_message, args, proc_style_tags, true);
+}
+
+#ifdef PICO_LOG_TOKENIZED
+// Sends a tokenized message: only the token ID and the raw arguments are captured, nothing is formatted.
+inline void Logger::vlog_token(const log_token_t* token, va_list args) {
+    assert(token != nullptr);
+
+    const LOG_LEVEL_t level = (LOG_LEVEL_t) token->level;
+    uint8_t payload[TOKEN_PAYLOAD_SIZE];
+    memcpy(payload, &token->id, sizeof(token->id));
+    const size_t args_len = log_args_capture(token->format, args, payload + sizeof(token->id), LOGGER_RECORD_ARGS_SIZE, true);
+
+    if (this->options->suppress_repeats && 
+        this->repeat_check(level, token->format, hash_bytes(2166136261u, payload + sizeof(token->id), args_len), 
+                           token->func, token->file, token->line)) {
+        return;
+    }
+
+    const log_context_t ctx = this->make_context(level, token->func, token->file, token->line);
+
+    if (this->options->deferred_logging || this->drain_engine_active) {
+        this->record_push_token(ctx, payload, sizeof(token->id) + args_len);
+        return;
+    }
+
+    switch (this->lock_message()) {
+        case LOCK_QUEUE:
+            this->record_push_token(ctx, payload, sizeof(token->id) + args_len);
+
+            if (this->try_take_log_mutex()) {
+                this->release_log_mutex_drain();
+            }
+            return;
+        case LOCK_SKIPPED:
+            return;
+        case LOCK_TAKEN:
+            break;
+    }
+
+    this->record_output_all();
+    this->token_output(level, ctx.timestamp_ms, payload, sizeof(token->id) + args_len);
+    this->release_log_mutex_drain();
+}
+#endif
+
 inline bool Logger::take_log_mutex() {
     #ifdef PICO_LOG_FREERTOS
     return log_mutex == nullptr || xSemaphoreTake(log_mutex, portMAX_DELAY) == pdTRUE;
@@ -113,6 +590,97 @@ inline bool Logger::take_log_mutex() {
     #endif
 }
 
+inline bool Logger::try_take_log_mutex() {
+    #ifdef PICO_LOG_FREERTOS
+    return log_mutex == nullptr || xSemaphoreTake(log_mutex, 0) == pdTRUE;
+    #else
+    return !this->mutex_initialized || mutex_try_enter(&this->log_mutex, nullptr);
+    #endif
+}
+
+inline bool Logger::take_log_mutex_timeout(const uint32_t timeout_us) {
+    #ifdef PICO_LOG_FREERTOS
+    // Rounded up to whole ticks, so the wait is never shorter than requested.
+    const TickType_t ticks = (timeout_us + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000);
+    return log_mutex == nullptr || xSemaphoreTake(log_mutex, ticks) == pdTRUE;
+    #else
+    return !this->mutex_initialized || mutex_enter_timeout_us(&this->log_mutex, timeout_us);
+    #endif
+}
+
+// Takes the log mutex for a message, or decides what to do with it if the mutex 
+// is held by another core or task (see LOG_LOCK_POLICY_t). Skipped messages are counted.
+inline Logger::LOG_LOCK_RESULT Logger::lock_message() {
+    if (this->try_take_log_mutex()) {
+        return LOCK_TAKEN;
+    }
+
+    switch (this->options->lock_policy) {
+        case LOG_LOCK_BLOCK:
+            if (this->take_log_mutex()) {
+                return LOCK_TAKEN;
+            }
+            break;
+        case LOG_LOCK_TIMEOUT:
+            if (this->take_log_mutex_timeout(this->options->lock_timeout_us)) {
+                return LOCK_TAKEN;
+            }
+            break;
+        case LOG_LOCK_TRY:
+            break;
+        default:
+            return LOCK_QUEUE;
+    }
+
+    const uint32_t irq_state = spin_lock_blocking(this->record_lock);
+    this->messages_skipped++;
+    spin_unlock(this->record_lock, irq_state);
+    return LOCK_SKIPPED;
+}
+
+// Returns true if a message is identical to the last one (same call site, format and arguments), 
+// counting it as a repeat. Otherwise, it becomes the last message. The repeats are logged as a single line,
+// with the call site of the repeated message, when a different message is logged, or every
+// LOGGER_REPEAT_FLUSH_MS while the message keeps repeating.
+inline bool Logger::repeat_check(const LOG_LEVEL_t level, const char* message, const uint32_t args_hash, 
+                                 const char* func, const char* file, const uint16_t line) {
+    if (message == REPEAT_MESSAGE) {
+        return false;
+    }
+
+    const uint32_t irq_state = spin_lock_blocking(this->record_lock);
+    repeat_state_t previous = this->last_message;
+    const bool repeated = message == previous.message && args_hash == previous.args_hash && 
+                          line == previous.line && level == previous.level && file == previous.file;
+    bool report = previous.count > 0;
+
+    if (repeated) {
+        const uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+
+        if (this->last_message.count++ == 0) {
+            this->last_message.since_ms = now_ms;
+        }
+
+        previous = this->last_message;
+        report = now_ms - previous.since_ms >= LOGGER_REPEAT_FLUSH_MS;
+
+        if (report) {
+            this->last_message.count = 0;
+        }
+    } else {
+        this->last_message = {message, args_hash, 0, 0, func, file, line, level};
+    }
+
+    spin_unlock(this->record_lock, irq_state);
+
+    if (report) {
+        const log_typed_arg_t args[] = {log_typed_arg(previous.count), {}};
+        this->vlog_typed(previous.level, REPEAT_MESSAGE, nullptr, args, 1, previous.func, previous.file, previous.line, false);
+    }
+
+    return repeated;
+}
+
 inline void Logger::release_log_mutex() {
     #ifdef PICO_LOG_FREERTOS
     if (log_mutex != nullptr) {
@@ -125,11 +693,460 @@ inline void Logger::release_log_mutex() {
     #endif
 }
 
-constexpr uint8_t Logger::ansi_color_code(const color_spec_t clr_spec) {
-    return ((uint8_t)clr_spec.color) + 30 + (clr_spec.background ? 10 : 0) + (clr_spec.high_intensity ? 60 : 0);
+inline Logger::log_context_t Logger::make_context(const LOG_LEVEL_t level, const char* func, const char* file, const uint16_t line) {
+    log_context_t ctx = {func, file, line, level, to_ms_since_boot(get_absolute_time()), (uint8_t) get_core_num(), nullptr};
+
+    #ifdef PICO_LOG_FREERTOS
+    ctx.task = (xTaskGetCurrentTaskHandle() != nullptr) ? pcTaskGetName(nullptr) : "UNKNOWN";
+    #else
+    ctx.task = "NO TASK";
+    #endif
+
+    return ctx;
+}
+
+#ifdef PICO_LOG_FREERTOS
+// Background log task: outputs records as they are committed, blocking in between.
+void Logger::log_task_entry(void* param) {
+    Logger* logger = static_cast<Logger*>(param);
+
+    while (true) {
+        // Notifications given since the last drain() are counted, so none are missed.
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        logger->drain();
+    }
+}
+#else
+// Core 1 log server: outputs records as they are committed, sleeping in between.
+void Logger::core1_drain_entry() {
+    while (true) {
+        core1_drain_logger->drain();
+
+        // Woken up by record_notify() (or any other event).
+        // An event sent since the last drain() is latched, so none are missed.
+        __wfe();
+    }
+}
+#endif
+
+// Notifies the drain engine (if any) that a record has been committed.
+inline void Logger::record_notify(const bool from_isr) {
+    if (this->drain_engine_active) {
+        #ifdef PICO_LOG_FREERTOS
+        if (from_isr) {
+            BaseType_t task_woken = pdFALSE;
+            vTaskNotifyGiveFromISR(this->log_task, &task_woken);
+            portYIELD_FROM_ISR(task_woken);
+        } else {
+            xTaskNotifyGive(this->log_task);
+        }
+        #else
+        (void) from_isr;
+        __sev();
+        #endif
+    }
+}
+
+// Reserves space for a record in the record buffer. Only the buffer indices are updated
+// while holding the spin lock, the record itself is written and committed without it.
+// Returns nullptr (and counts the record as dropped) if the buffer is full.
+inline Logger::log_record_t* Logger::record_reserve(const uint32_t record_size) {
+    log_record_t* record = nullptr;
+    const uint32_t irq_state = spin_lock_blocking(this->record_lock);
+    const uint32_t head = this->record_head.load(std::memory_order_relaxed);
+    const uint32_t offset = head & (LOGGER_RECORD_BUFF_SIZE - 1);
+    const uint32_t contiguous = LOGGER_RECORD_BUFF_SIZE - offset;
+    const uint32_t required = record_size + (contiguous < record_size ? contiguous : 0);
+
+    if (LOGGER_RECORD_BUFF_SIZE - (head - this->record_tail.load(std::memory_order_acquire)) >= required) {
+        // Records are never split, pad the rest of the buffer if it doesn't fit.
+        if (contiguous < record_size) {
+            log_record_t* padding = reinterpret_cast<log_record_t*>(this->record_buff + offset);
+            padding->size = contiguous;
+            padding->flags = RECORD_FLAG_PADDING;
+            padding->state = RECORD_STATE_COMMITTED;
+        }
+
+        record = reinterpret_cast<log_record_t*>(this->record_buff + ((head + required - record_size) & (LOGGER_RECORD_BUFF_SIZE - 1)));
+        record->size = record_size;
+        record->state = RECORD_STATE_RESERVED;
+        this->record_head.store(head + required, std::memory_order_release);
+    } else {
+        this->records_dropped++;
+    }
+
+    spin_unlock(this->record_lock, irq_state);
+    return record;
+}
+
+// Marks a reserved record as ready to be output.
+inline void Logger::record_commit(log_record_t* record) {
+    __dmb();
+    record->state = RECORD_STATE_COMMITTED;
+}
+
+// Returns true if the oldest record in the record buffer is committed.
+inline bool Logger::record_pending() {
+    const uint32_t tail = this->record_tail.load(std::memory_order_relaxed);
+    
+    if (tail == this->record_head.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    return reinterpret_cast<const log_record_t*>(this->record_buff + (tail & (LOGGER_RECORD_BUFF_SIZE - 1)))->state == RECORD_STATE_COMMITTED;
+}
+
+// Reserves a record with space for data_len bytes after the header, and fills in the header.
+// Returns nullptr if the record buffer is full.
+inline Logger::log_record_t* Logger::record_create(const log_context_t& ctx, const size_t data_len, const uint8_t flags) {
+    const uint32_t record_size = (sizeof(log_record_t) + data_len + alignof(log_record_t) - 1) & ~(alignof(log_record_t) - 1);
+    log_record_t* record = this->record_reserve(record_size);
+
+    if (record == nullptr) {
+        return nullptr;
+    }
+
+    record->flags = flags;
+    record->level = ctx.level;
+    record->line = ctx.line;
+    record->core = ctx.core;
+    record->args_len = 0;
+    record->timestamp_ms = ctx.timestamp_ms;
+    record->func = ctx.func;
+    record->file = ctx.file;
+    record->message = nullptr;
+    #ifdef PICO_LOG_FREERTOS
+    strncpy(record->task_name, ctx.task, configMAX_TASK_NAME_LEN - 1);
+    record->task_name[configMAX_TASK_NAME_LEN - 1] = '\0';
+    #endif
+
+    return record;
+}
+
+// Copies a log message and its raw arguments into the record buffer.
+// Takes bounded time and is interrupt-safe (the spin lock disables interrupts while it is held).
+inline void Logger::record_push(const log_context_t& ctx, const char* message, const char* plain_message, 
+                                va_list args, const bool proc_style_tags, const bool from_isr) {
+    uint8_t args_buff[LOGGER_RECORD_ARGS_SIZE];
+    const size_t args_len = log_args_capture(message, args, args_buff, LOGGER_RECORD_ARGS_SIZE, proc_style_tags);
+    const bool plain = plain_message != nullptr && plain_message != message && this->sinks_need_variant(ctx.level, false);
+    log_record_t* record = this->record_create(ctx, args_len + (plain ? sizeof(plain_message) : 0), 
+                                               (proc_style_tags ? RECORD_FLAG_STYLE_TAGS : 0) | (plain ? RECORD_FLAG_PLAIN : 0));
+
+    if (record == nullptr) {
+        return;
+    }
+
+    record->args_len = args_len;
+    record->message = message;
+    memcpy(record + 1, args_buff, args_len);
+
+    if (plain) {
+        memcpy(reinterpret_cast<uint8_t*>(record + 1) + args_len, &plain_message, sizeof(plain_message));
+    }
+
+    this->record_commit(record);
+    this->record_notify(from_isr);
+}
+
+// Formats a log_typed() message and copies it into the record buffer as text.
+// A plain variant is added if it differs, and sinks without ANSI styling need it.
+// Each variant is formatted with one extra character, to tell whether it has to be truncated (see fit_text()).
+inline void Logger::record_push_text(const log_context_t& ctx, const char* message, const char* plain_message, 
+                                     const log_typed_arg_t* args, const size_t num_args, const bool proc_style_tags) {
+    char text[(LOGGER_RECORD_TEXT_SIZE + 1) * 2];
+    const size_t full_len = log_typed_format(text, LOGGER_RECORD_TEXT_SIZE + 1, message, args, num_args, 
+                                             proc_style_tags ? STYLE_TAGS_TRANSLATE : STYLE_TAGS_KEEP);
+    const size_t text_len = fit_text(text, full_len);
+    size_t plain_len = 0;
+
+    if ((proc_style_tags || (plain_message != nullptr && plain_message != message)) && this->sinks_need_variant(ctx.level, false)) {
+        plain_len = fit_text(text + text_len + 1, log_typed_format(text + text_len + 1, LOGGER_RECORD_TEXT_SIZE + 1, 
+                                                                   plain_message ? plain_message : message, args, num_args, 
+                                                                   proc_style_tags ? STYLE_TAGS_REMOVE : STYLE_TAGS_KEEP)) + 1;
+    }
+
+    this->record_push_chars(ctx, text, text_len + 1 + plain_len, plain_len > 0, full_len != text_len);
+}
+
+// Formats a printf-style message and copies it into the record buffer as text (see record_push_text() above).
+inline void Logger::record_push_text(const log_context_t& ctx, const char* message, const char* plain_message, 
+                                     va_list args, const bool proc_style_tags) {
+    char text[(LOGGER_RECORD_TEXT_SIZE + 1) * 2];
+    const size_t full_len = format_text(text, LOGGER_RECORD_TEXT_SIZE + 1, message, args, 
+                                        proc_style_tags ? STYLE_TAGS_TRANSLATE : STYLE_TAGS_KEEP);
+    const size_t text_len = fit_text(text, full_len);
+    size_t plain_len = 0;
+
+    if ((proc_style_tags || (plain_message != nullptr && plain_message != message)) && this->sinks_need_variant(ctx.level, false)) {
+        plain_len = fit_text(text + text_len + 1, format_text(text + text_len + 1, LOGGER_RECORD_TEXT_SIZE + 1, 
+                                                              plain_message ? plain_message : message, args, 
+                                                              proc_style_tags ? STYLE_TAGS_REMOVE : STYLE_TAGS_KEEP)) + 1;
+    }
+
+    this->record_push_chars(ctx, text, text_len + 1 + plain_len, plain_len > 0, full_len != text_len);
+}
+
+// Copies a formatted message (null-terminated, followed by its null-terminated plain variant if plain is true)
+// into the record buffer. Truncated messages are counted.
+inline void Logger::record_push_chars(const log_context_t& ctx, const char* text, const size_t len, const bool plain, const bool truncated) {
+    log_record_t* record = this->record_create(ctx, len, RECORD_FLAG_TEXT | (plain ? RECORD_FLAG_PLAIN : 0));
+
+    if (record == nullptr) {
+        return;
+    }
+
+    if (truncated) {
+        const uint32_t irq_state = spin_lock_blocking(this->record_lock);
+        this->messages_truncated++;
+        spin_unlock(this->record_lock, irq_state);
+    }
+
+    memcpy(record + 1, text, len);
+
+    this->record_commit(record);
+    this->record_notify(false);
+}
+
+#ifdef PICO_LOG_TOKENIZED
+// Copies a tokenized message payload (token ID and captured arguments) into the record buffer.
+inline void Logger::record_push_token(const log_context_t& ctx, const uint8_t* payload, const size_t payload_len) {
+    log_record_t* record = this->record_create(ctx, payload_len, RECORD_FLAG_TOKEN);
+
+    if (record == nullptr) {
+        return;
+    }
+
+    record->args_len = payload_len;
+    memcpy(record + 1, payload, payload_len);
+
+    this->record_commit(record);
+    this->record_notify(false);
+}
+#endif
+
+// Formats and outputs a deferred record.
+inline void Logger::record_output(const log_record_t* record) {
+    #ifdef PICO_LOG_TOKENIZED
+    if (record->flags & RECORD_FLAG_TOKEN) {
+        this->token_output((LOG_LEVEL_t) record->level, record->timestamp_ms, reinterpret_cast<const uint8_t*>(record + 1), record->args_len);
+        return;
+    }
+    #endif
+
+    log_context_t ctx = {record->func, record->file, record->line, (LOG_LEVEL_t) record->level, 
+                         record->timestamp_ms, record->core, nullptr};
+    #ifdef PICO_LOG_FREERTOS
+    ctx.task = record->task_name;
+    #else
+    ctx.task = "NO TASK";
+    #endif
+
+    // Text records are already formatted.
+    if (record->flags & RECORD_FLAG_TEXT) {
+        const char* text = reinterpret_cast<const char*>(record + 1);
+        const char* plain_text = (record->flags & RECORD_FLAG_PLAIN) ? text + strlen(text) + 1 : nullptr;
+        this->msg_output(ctx, {MESSAGE_TEXT, text, plain_text});
+        return;
+    }
+
+    log_message_t msg = {MESSAGE_CAPTURED, record->message, nullptr, (record->flags & RECORD_FLAG_STYLE_TAGS) != 0};
+    msg.captured_args = reinterpret_cast<const uint8_t*>(record + 1);
+    msg.captured_args_len = record->args_len;
+
+    if (record->flags & RECORD_FLAG_PLAIN) {
+        memcpy(&msg.plain_format, msg.captured_args + record->args_len, sizeof(msg.plain_format));
+    }
+
+    this->msg_output(ctx, msg);
+}
+
+// Outputs and frees all committed records, oldest first. Stops at the first record
+// that is still being written. Must be called with the log mutex held.
+// Returns the number of records output.
+inline size_t Logger::record_output_all() {
+    size_t num_records = 0;
+
+    while (this->record_pending()) {
+        const uint32_t tail = this->record_tail.load(std::memory_order_relaxed);
+        const log_record_t* record = reinterpret_cast<const log_record_t*>(this->record_buff + (tail & (LOGGER_RECORD_BUFF_SIZE - 1)));
+        __dmb();
+
+        if (!(record->flags & RECORD_FLAG_PADDING)) {
+            this->record_output(record);
+            num_records++;
+        }
+
+        this->record_tail.store(tail + record->size, std::memory_order_release);
+    }
+
+    this->report_dropped();
+    this->report_repeats();
+    return num_records;
+}
+
+// Outputs a "N messages dropped" line if messages were dropped (record buffer full, 
+// or skipped by the lock policy) since the last one, and a "N messages truncated" line 
+// if messages were truncated when queued as text. Must be called with the log mutex held.
+inline void Logger::report_dropped() {
+    this->report_count(this->records_dropped + this->messages_skipped, this->dropped_reported, " messages dropped");
+    this->report_count(this->messages_truncated, this->truncated_reported, " messages truncated");
+}
+
+// Outputs a "N <what>" line (at the LOG_LVL_WARN level) with the increase of a counter since the last such line.
+inline void Logger::report_count(const uint32_t count, uint32_t& reported, const char* what) {
+    if (count == reported) {
+        return;
+    }
+
+    char text[32];
+    const size_t len = uint_to_str(count - reported, text, 1);
+    strcpy(text + len, what);
+    reported = count;
+
+    const log_context_t ctx = this->make_context(LOG_LVL_WARN, __func__, __FILE__, __LINE__);
+    this->msg_output(ctx, {MESSAGE_TEXT, text});
+}
+
+// Outputs the repeats of the last message if they have been counted for LOGGER_REPEAT_FLUSH_MS,
+// so that they are not lost when the message stops repeating and nothing else is logged.
+// Must be called with the log mutex held.
+inline void Logger::report_repeats() {
+    if (!this->options->suppress_repeats) {
+        return;
+    }
+
+    const uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+    const uint32_t irq_state = spin_lock_blocking(this->record_lock);
+    const repeat_state_t previous = this->last_message;
+    const bool report = previous.count > 0 && now_ms - previous.since_ms >= LOGGER_REPEAT_FLUSH_MS;
+
+    if (report) {
+        this->last_message.count = 0;
+    }
+
+    spin_unlock(this->record_lock, irq_state);
+
+    if (report) {
+        const log_typed_arg_t args[] = {log_typed_arg(previous.count), {}};
+        log_message_t msg = {MESSAGE_TYPED, REPEAT_MESSAGE, nullptr, false};
+        msg.typed_args = args;
+        msg.num_typed_args = 1;
+
+        this->msg_output(this->make_context(previous.level, previous.func, previous.file, previous.line), msg);
+    }
+}
+
+#ifdef PICO_LOG_TOKENIZED
+// Adds the timestamp to a tokenized message payload, and writes it as a frame to the sinks that accept its level.
+// Timestamps are sent as the delta to the previous tokenized message, and periodically in full.
+// Must be called with the log mutex held.
+inline void Logger::token_output(const LOG_LEVEL_t level, const uint32_t timestamp_ms, const uint8_t* payload, const size_t payload_len) {
+    uint8_t record_payload[TOKEN_PAYLOAD_SIZE + LOG_WIRE_VARINT_MAX_LEN];
+    const bool absolute = this->token_count % LOGGER_TOKEN_SYNC_INTERVAL == 0;
+    size_t record_len = sizeof(uint32_t);
+
+    memcpy(record_payload, payload, sizeof(uint32_t));
+    record_len += log_wire_varint(log_wire_timestamp(timestamp_ms, this->token_last_ms, absolute), record_payload + record_len);
+    memcpy(record_payload + record_len, payload + sizeof(uint32_t), payload_len - sizeof(uint32_t));
+    record_len += payload_len - sizeof(uint32_t);
+
+    this->token_last_ms = timestamp_ms;
+    this->token_count++;
+
+    const size_t frame_len = this->frame_encode(record_payload, record_len, false);
+
+    for (size_t i = 0; i < this->num_sinks; i++) {
+        if (level >= this->sinks[i].level) {
+            this->sinks[i].sink.out_chars(this->sinks[i].sink.ctx, reinterpret_cast<const char*>(this->frame_buff), frame_len);
+        }
+    }
 }
 
-constexpr const char* Logger::log_lvl_str(const LOG_LEVEL_t level) {
+// Encodes a payload into frame_buff (COBS-encoded, followed by a zero byte). Returns the frame length.
+// Text frames get the LOG_TOKEN_TEXT prefix, which encodes to four 0x01 bytes.
+inline size_t Logger::frame_encode(const uint8_t* payload, const size_t payload_len, const bool text) {
+    size_t frame_len = 0;
+
+    if (text) {
+        memset(this->frame_buff, 0x01, sizeof(LOG_TOKEN_TEXT));
+        frame_len = sizeof(LOG_TOKEN_TEXT);
+    }
+
+    frame_len += log_wire_cobs(payload, payload_len, this->frame_buff + frame_len);
+    this->frame_buff[frame_len++] = 0;
+    return frame_len;
+}
+#endif
+
+// Formats a message with the log format and writes the result to the sinks that accept its level.
+// The message is formatted at most once with and once without ANSI styling, in the same buffer.
+// The result is passed as a list of segments, unless one of the sinks only supports out_chars.
+inline void Logger::msg_output(const log_context_t& ctx, const log_message_t& msg) {
+    log_segment_t segments[LOGGER_MAX_SEGMENTS];
+
+    for (const bool ansi_styling : {true, false}) {
+        bool needed = false, segmented = true;
+
+        // Frames are encoded from contiguous messages.
+        #ifdef PICO_LOG_TOKENIZED
+        segmented = false;
+        #endif
+
+        for (size_t i = 0; i < this->num_sinks; i++) {
+            if (ctx.level >= this->sinks[i].level && this->sink_styled(i) == ansi_styling) {
+                needed = true;
+                segmented &= this->sinks[i].sink.out_segments != nullptr;
+            }
+        }
+
+        if (!needed) {
+            continue;
+        }
+
+        log_output_t out = {this->output_buff, LOGGER_BUFF_SIZE};
+
+        if (segmented) {
+            out.segments = segments;
+            out.max_segments = LOGGER_MAX_SEGMENTS;
+        }
+
+        this->msg_process_format(out, msg, ctx, ansi_styling);
+
+        #ifdef PICO_LOG_TOKENIZED
+        const size_t frame_len = this->frame_encode(reinterpret_cast<const uint8_t*>(out.buff), out.buff_pos, true);
+        #endif
+
+        for (size_t i = 0; i < this->num_sinks; i++) {
+            const log_sink_t& sink = this->sinks[i].sink;
+
+            if (ctx.level < this->sinks[i].level || this->sink_styled(i) != ansi_styling) {
+                continue;
+            }
+
+            #ifdef PICO_LOG_TOKENIZED
+            sink.out_chars(sink.ctx, reinterpret_cast<const char*>(this->frame_buff), frame_len);
+            #else
+            if (out.segments != nullptr) {
+                sink.out_segments(sink.ctx, out.segments, out.num_segments);
+            } else {
+                sink.out_chars(sink.ctx, out.buff, out.buff_pos);
+            }
+            #endif
+        }
+    }
+}
+
+// Releases the log mutex. Records committed by other cores or tasks while the mutex 
+// was held are output first, and again after releasing, unless someone else holds the mutex by then.
+inline void Logger::release_log_mutex_drain() {
+    do {
+        this->record_output_all();
+        this->release_log_mutex();
+    } while (this->record_pending() && this->try_take_log_mutex());
+}
+
+constexpr const char* log_lvl_str(const LOG_LEVEL_t level) {
     switch (level) {
         case LOG_LVL_DEBUG: return "DEBUG";
         case LOG_LVL_INFO:  return "INFO";
@@ -140,363 +1157,287 @@ constexpr const char* Logger::log_lvl_str(const LOG_LEVEL_t level) {
     }
 }
 
-constexpr uint8_t Logger::log_lvl_color(const LOG_LEVEL_t level) {
+constexpr uint8_t log_lvl_color(const LOG_LEVEL_t level) {
     switch (level) {
-        case LOG_LVL_DEBUG: return ansi_color_code({COLOR_CYAN, false, false, false});
-        case LOG_LVL_INFO:  return ansi_color_code({COLOR_BLUE, false, false, false});
-        case LOG_LVL_WARN:  return ansi_color_code({COLOR_YELLOW, false, false, false});
-        case LOG_LVL_ERROR: return ansi_color_code({COLOR_RED, false, false, false});
-        case LOG_LVL_FATAL: return ansi_color_code({COLOR_MAGENTA, false, false, false});
-        default:            return ansi_color_code({COLOR_WHITE, false, false, false});
+        case LOG_LVL_DEBUG: return style_tag_parse("%CYN%").color_code;
+        case LOG_LVL_INFO:  return style_tag_parse("%BLU%").color_code;
+        case LOG_LVL_WARN:  return style_tag_parse("%YLW%").color_code;
+        case LOG_LVL_ERROR: return style_tag_parse("%RED%").color_code;
+        case LOG_LVL_FATAL: return style_tag_parse("%MGT%").color_code;
+        default:            return style_tag_parse("%WHT%").color_code;
     }
 }
 
-inline Logger::color_spec_t Logger::process_color_spec(const COLOR color, const char* &src_ptr, const size_t ptr_skip) {
-    color_spec_t clr_spec = {color, false, false, true};
-    src_ptr += ptr_skip;
-    
-    if (*src_ptr == '%') {
-        src_ptr++;
-        return clr_spec;
-    }
+// Pre-rendered level label.
+struct log_level_label {
+    char str[24] = {};
+    uint8_t len = 0;
+};
+typedef struct log_level_label log_level_label_t;
 
-    for (size_t i = 0; *src_ptr && *src_ptr != '%' && i < 4; i++) {
-        src_ptr++;
-        if (*(src_ptr - 1) != '_') {
-            continue;
-        }
+// Number of level labels (all levels, followed by the label of unknown levels).
+constexpr size_t LOG_LEVEL_NUM_LABELS = LOG_LVL_FATAL + 2;
+
+// Level labels, without and with color, rendered at compile-time.
+constexpr auto LOG_LEVEL_LABELS = [] {
+    std::array<std::array<log_level_label_t, LOG_LEVEL_NUM_LABELS>, 2> labels = {};
 
-        if (memcmp(src_ptr, "HI", 2) == 0) {
-            clr_spec.high_intensity = true;
-            src_ptr += 2;
-        } else if (memcmp(src_ptr, "BG", 2) == 0) {
-            clr_spec.background = true;
-            src_ptr += 2;
+    for (size_t styled = 0; styled < 2; styled++) {
+        for (size_t level = 0; level < LOG_LEVEL_NUM_LABELS; level++) {
+            log_level_label_t& label = labels[styled][level];
+            const style_escape_t& color = style_color_escape(log_lvl_color((LOG_LEVEL_t) level));
+            const char* level_str = log_lvl_str((LOG_LEVEL_t) level);
+            const char* reset = ANSI_RESET;
+
+            for (size_t i = 0; styled && i < color.len; i++) {
+                label.str[label.len++] = color.str[i];
+            }
+
+            while (*level_str) {
+                label.str[label.len++] = *level_str++;
+            }
+
+            while (styled && *reset) {
+                label.str[label.len++] = *reset++;
+            }
         }
     }
 
-    if (*src_ptr == '%') {
-        src_ptr++;
-        return clr_spec;
+    return labels;
+}();
+
+// Returns the pre-rendered label of a level.
+static inline const log_level_label_t& log_lvl_label(const LOG_LEVEL_t level, const bool ansi_styling) {
+    return LOG_LEVEL_LABELS[ansi_styling][((size_t) level < LOG_LEVEL_NUM_LABELS - 1) ? (size_t) level : LOG_LEVEL_NUM_LABELS - 1];
+}
+
+#ifndef PICO_LOG_STATIC_FORMAT
+void Logger::msg_format_tokenize() {
+    // Style and color tags are skipped in the plain tokens.
+    for (const bool ansi_styling : {false, true}) {
+        (void) log_format_tokenize(this->options->log_format, this->log_format_tokens[ansi_styling], LOG_FORMAT_MAX_TOKENS, ansi_styling, 
+                                   this->log_format_arena[ansi_styling], LOG_FORMAT_ARENA_SIZE);
+    }
+}
+
+void Logger::clear_format_tokens() {
+    for (uint32_t i = 0; i < LOG_FORMAT_MAX_TOKENS; i++) {
+        this->log_format_tokens[false][i].type = FORMAT_TOKEN_END;
+        this->log_format_tokens[true][i].type = FORMAT_TOKEN_END;
     }
+}
+#else
+constexpr char STATIC_LOG_FORMAT[] = PICO_LOG_STATIC_FORMAT;
+
+template <bool ansi_styling>
+constexpr size_t STATIC_FORMAT_ARENA_SIZE = log_format_text_len(STATIC_LOG_FORMAT, ansi_styling) + 1;
 
-    clr_spec.success = false;
-    return clr_spec;
+// Renders the text parts of the compile-time log format string.
+template <bool ansi_styling>
+consteval auto static_format_arena() {
+    std::array<log_format_token_t, log_format_token_count(STATIC_LOG_FORMAT, ansi_styling)> tokens;
+    std::array<char, STATIC_FORMAT_ARENA_SIZE<ansi_styling>> arena = {};
+    (void) log_format_tokenize(STATIC_LOG_FORMAT, tokens.data(), tokens.size(), ansi_styling, arena.data(), arena.size());
+    return arena;
 }
 
-#define ADD_FORMAT_TOKEN(tkn_type, ptr_skip)                \
-    if (this->options->ansi_styling) {                      \
-        this->log_format_tokens[token_num].type = tkn_type; \
-        token_num++;                                        \
-    }                                                       \
-    src_ptr += ptr_skip;                                    \
-    continue;
+template <bool ansi_styling>
+constexpr auto STATIC_FORMAT_ARENA = static_format_arena<ansi_styling>();
 
-#define ADD_FORMAT_TOKEN_STL(ansi_style, ptr_skip)           \
-    this->log_format_tokens[token_num].str_ptr = ansi_style; \
-    ADD_FORMAT_TOKEN(FORMAT_TOKEN_STYLE, ptr_skip);
+// Tokenizes the compile-time log format string. Text tokens point into STATIC_FORMAT_ARENA.
+template <bool ansi_styling>
+consteval auto static_format_tokens() {
+    std::array<log_format_token_t, log_format_token_count(STATIC_LOG_FORMAT, ansi_styling)> tokens;
+    std::array<char, STATIC_FORMAT_ARENA_SIZE<ansi_styling>> arena = {};
+    (void) log_format_tokenize(STATIC_LOG_FORMAT, tokens.data(), tokens.size(), ansi_styling, arena.data(), arena.size());
 
-#define ADD_FORMAT_TOKEN_CLR(color, ptr_skip)                                      \
-    clr_spec = process_color_spec(color, src_ptr, ptr_skip);                       \
-    if (clr_spec.success) {                                                        \
-        this->log_format_tokens[token_num].color_code = ansi_color_code(clr_spec); \
-        ADD_FORMAT_TOKEN(FORMAT_TOKEN_COLOR, 0);                                   \
+    for (log_format_token_t& token : tokens) {
+        if (token.type == FORMAT_TOKEN_TEXT) {
+            token.str_ptr = STATIC_FORMAT_ARENA<ansi_styling>.data() + (token.str_ptr - arena.data());
+        }
     }
 
-void Logger::msg_format_tokenize() {
-    uint32_t token_num = 0;
-    const char* src_ptr = this->options->log_format;
-    color_spec_t clr_spec;
-    
-    while (*src_ptr && token_num < LOG_FORMAT_MAX_TOKENS) {
-        if (*src_ptr == '%') {
-            src_ptr++;
-            if (this->log_format_tokens[token_num].type == FORMAT_TOKEN_TEXT) {
-                token_num++;
-            }
+    return tokens;
+}
 
-            switch (*src_ptr) {
-                case 'T':
-                    if (memcmp(src_ptr, "TSTMP%", 6) == 0) {
-                        ADD_FORMAT_TOKEN(FORMAT_TOKEN_TIMESTAMP, 6);
-                    } else if (memcmp(src_ptr, "TASK%", 5) == 0) {
-                        ADD_FORMAT_TOKEN(FORMAT_TOKEN_TASK, 5);
-                    }
-                    break;
-                case 'L':
-                    if (memcmp(src_ptr, "LVL%", 4) == 0) {
-                        ADD_FORMAT_TOKEN(FORMAT_TOKEN_LEVEL, 4);
-                    } else if (memcmp(src_ptr, "LINE%", 5) == 0) {
-                        ADD_FORMAT_TOKEN(FORMAT_TOKEN_LINE, 5);
-                    }
-                    break;
-                case 'F':
-                    if (memcmp(src_ptr, "FILE%", 5) == 0) {
-                        ADD_FORMAT_TOKEN(FORMAT_TOKEN_FILE, 5);
-                    } else if (memcmp(src_ptr, "FUNC%", 5) == 0) {
-                        ADD_FORMAT_TOKEN(FORMAT_TOKEN_FUNC, 5);
-                    }
-                    break;
-                case 'M':
-                    if (memcmp(src_ptr, "MSG%", 4) == 0) {
-                        ADD_FORMAT_TOKEN(FORMAT_TOKEN_MSG, 4);
-                    } else if (memcmp(src_ptr, "MGT", 3) == 0) {
-                        ADD_FORMAT_TOKEN_CLR(COLOR_MAGENTA, 3);
-                    }
-                    break;
-                case 'I':
-                    if (memcmp(src_ptr, "ITL%", 4) == 0) {
-                        ADD_FORMAT_TOKEN_STL(ANSI_ITALIC, 4);
-                    }
-                    break;
-                case 'U':
-                    if (memcmp(src_ptr, "UDRLN%", 6) == 0) {
-                        ADD_FORMAT_TOKEN_STL(ANSI_UNDERLINE, 6);
-                    }
-                    break;
-                case 'S':
-                    if (memcmp(src_ptr, "STKTHR%", 7) == 0) {
-                        ADD_FORMAT_TOKEN_STL(ANSI_STRIKETHROUGH, 7);
-                    }
-                    break;
-                case 'B':
-                    if (memcmp(src_ptr, "BOLD%", 5) == 0) {
-                        ADD_FORMAT_TOKEN_STL(ANSI_BOLD, 5);
-                    } else if (memcmp(src_ptr, "BLU", 3) == 0) {
-                        ADD_FORMAT_TOKEN_CLR(COLOR_BLUE, 3);
-                    } else if (memcmp(src_ptr, "BLK", 3) == 0) {
-                        ADD_FORMAT_TOKEN_CLR(COLOR_BLACK, 3);
-                    }
-                    break;
-                case 'R':
-                    if (memcmp(src_ptr, "RED", 3) == 0) {
-                        ADD_FORMAT_TOKEN_CLR(COLOR_RED, 3);
-                    } else if (memcmp(src_ptr, "RST%", 4) == 0) {
-                        ADD_FORMAT_TOKEN_STL(ANSI_RESET, 4);
-                    }
-                    break;
-                case 'G':
-                    if (memcmp(src_ptr, "GRN", 3) == 0) {
-                        ADD_FORMAT_TOKEN_CLR(COLOR_GREEN, 3);
-                    }
-                    break;
-                case 'Y':
-                    if (memcmp(src_ptr, "YLW", 3) == 0) {
-                        ADD_FORMAT_TOKEN_CLR(COLOR_YELLOW, 3);
-                    }
-                    break;
-                case 'C':
-                    if (memcmp(src_ptr, "CYN", 3) == 0) {
-                        ADD_FORMAT_TOKEN_CLR(COLOR_CYAN, 3);
-                    } else if (memcmp(src_ptr, "CORE%", 5) == 0) {
-                        ADD_FORMAT_TOKEN(FORMAT_TOKEN_CORE, 5);
-                    }
-                    break;
-                case 'W':
-                    if (memcmp(src_ptr, "WHT", 3) == 0) {
-                        ADD_FORMAT_TOKEN_CLR(COLOR_WHITE, 3);
-                    }
-                    break;
-            }
+template <bool ansi_styling>
+constexpr auto STATIC_FORMAT_TOKENS = static_format_tokens<ansi_styling>();
 
-            continue;
-        }
-            
-        if (this->log_format_tokens[token_num].type != FORMAT_TOKEN_TEXT) {
-            this->log_format_tokens[token_num].type = FORMAT_TOKEN_TEXT;
-            this->log_format_tokens[token_num].str_ptr = src_ptr;
-            this->log_format_tokens[token_num].txt_token_len = 1;
-        } else {
-            this->log_format_tokens[token_num].txt_token_len++;
-        }
+// Formats a message with the compile-time log format.
+// Expands to one call per token, without the token loop.
+template <bool ansi_styling, size_t... token_idx>
+inline void Logger::msg_process_static_format(log_output_t& out, const log_message_t& msg, const log_context_t& ctx, 
+                                              std::index_sequence<token_idx...>) {
+    (this->msg_format_token<STATIC_FORMAT_TOKENS<ansi_styling>[token_idx].type>(STATIC_FORMAT_TOKENS<ansi_styling>[token_idx], 
+                                                                                 out, msg, ctx, ansi_styling), ...);
+    this->msg_format_end(out);
+}
+#endif
 
-        src_ptr++;
+// Writes a single log format token to the output.
+// Strings that stay valid until the message is output (including the timestamp cache) are constant.
+template <LOG_FORMAT_TOKEN_TYPE type>
+inline void Logger::msg_format_token(const log_format_token_t& token, log_output_t& out, 
+                                     const log_message_t& msg, const log_context_t& ctx, const bool ansi_styling) {
+    if constexpr (type == FORMAT_TOKEN_TEXT) {
+        // Text, style and color tags, pre-rendered by the tokenizer
+        output_const(out, token.str_ptr, token.txt_token_len);
+    } else if constexpr (type == FORMAT_TOKEN_FUNC) {
+        output_concat(out, ctx.func);
+    } else if constexpr (type == FORMAT_TOKEN_FILE) {
+        output_concat(out, ctx.file);
+    } else if constexpr (type == FORMAT_TOKEN_LINE) {
+        output_uint(out, ctx.line, 1);
+    } else if constexpr (type == FORMAT_TOKEN_TASK) {
+        output_concat(out, ctx.task);
+    } else if constexpr (type == FORMAT_TOKEN_LEVEL) {
+        const log_level_label_t& label = log_lvl_label(ctx.level, ansi_styling);
+        output_const(out, label.str, label.len);
+    } else if constexpr (type == FORMAT_TOKEN_TIMESTAMP) {
+        const uint32_t timestamp_millisec = this->timestamp_update(ctx.timestamp_ms);
+        output_const(out, this->timestamp.sec_str, this->timestamp.sec_str_len);
+        output_const(out, ".", 1);
+        output_uint(out, timestamp_millisec, 3);
+    } else if constexpr (type == FORMAT_TOKEN_CORE) {
+        output_const(out, ctx.core ? "core1" : "core0", 5);
+    } else if constexpr (type == FORMAT_TOKEN_MSG) {
+        this->msg_write(out, msg, ansi_styling);
     }
 }
 
-void Logger::clear_format_tokens() {
+#define FORMAT_TOKEN_CASE(tkn_type)                                                 \
+    case tkn_type:                                                                  \
+        this->msg_format_token<tkn_type>(token, out, msg, ctx, ansi_styling);       \
+        continue;
+
+inline void Logger::msg_process_format(log_output_t& out, const log_message_t& msg, const log_context_t& ctx, const bool ansi_styling) {
+    #ifdef PICO_LOG_STATIC_FORMAT
+    if (ansi_styling) {
+        this->msg_process_static_format<true>(out, msg, ctx, std::make_index_sequence<STATIC_FORMAT_TOKENS<true>.size()>());
+    } else {
+        this->msg_process_static_format<false>(out, msg, ctx, std::make_index_sequence<STATIC_FORMAT_TOKENS<false>.size()>());
+    }
+    #else
     for (uint32_t i = 0; i < LOG_FORMAT_MAX_TOKENS; i++) {
-        this->log_format_tokens[i].type = FORMAT_TOKEN_END;
-    }
-}
-
-#define BUFFER_CONCAT(str_ptr)                            \
-    str_len = strnlen(str_ptr, buff_size - buff_pos - 1); \
-    memcpy(buff + buff_pos, str_ptr, str_len);            \
-    buff_pos += str_len;                                  \
-    continue;
-
-#define BUFF_SPRINTF(fmt, ...)                                                             \
-    buff_pos_size_n = buff_size - buff_pos - 1;                                            \
-    str_len = snprintf(buff + buff_pos, buff_pos_size_n, fmt, __VA_ARGS__);                \
-    if (str_len > 0) {                                                                     \
-        buff_pos += str_len - (str_len > buff_pos_size_n ? str_len - buff_pos_size_n : 0); \
-    }                                                                                      \
-    continue;
-
-inline size_t Logger::msg_process_format(char* buff, const size_t buff_size, const char* msg, const LOG_LEVEL_t level, 
-                                         const char* func, const char* file, const uint16_t line) {
-    size_t token_len, str_len, buff_pos_size_n, buff_pos = 0;
-    uint32_t ms_since_boot, timestamp_sec;
-    uint16_t timestamp_millisec;
-    int str_len_diff;
-    
-    for (uint32_t i = 0; i < LOG_FORMAT_MAX_TOKENS && buff_pos < buff_size; i++) {
-        switch (this->log_format_tokens[i].type) {
-            case FORMAT_TOKEN_TEXT:
-                token_len = this->log_format_tokens[i].txt_token_len;
-                str_len_diff = (buff_size - buff_pos - 1) - token_len;
-                
-                if (str_len_diff < 0) {
-                    token_len += str_len_diff;
-                }
-                
-                memcpy(buff + buff_pos, this->log_format_tokens[i].str_ptr, token_len);
-                buff_pos += token_len;
-                continue;
-            case FORMAT_TOKEN_STYLE:
-                BUFFER_CONCAT(this->log_format_tokens[i].str_ptr);
-            case FORMAT_TOKEN_COLOR:
-                BUFF_SPRINTF("\033[0;%dm", this->log_format_tokens[i].color_code);
-            case FORMAT_TOKEN_FUNC:
-                BUFFER_CONCAT(func);
-            case FORMAT_TOKEN_FILE:
-                BUFFER_CONCAT(file);
-            case FORMAT_TOKEN_LINE:
-                BUFF_SPRINTF("%u", line);
-            case FORMAT_TOKEN_TASK:
-                #ifdef PICO_LOG_FREERTOS
-                if (xTaskGetCurrentTaskHandle() != nullptr) {
-                    BUFFER_CONCAT(pcTaskGetName(nullptr));
-                } else {
-                    BUFFER_CONCAT("UNKNOWN");
-                }
-                #else
-                BUFFER_CONCAT("NO TASK");
-                #endif
-            case FORMAT_TOKEN_LEVEL:
-                if (this->options->ansi_styling) {
-                    BUFF_SPRINTF("\033[0;%dm%s%s", log_lvl_color(level), log_lvl_str(level), ANSI_RESET);
-                }
-                
-                BUFFER_CONCAT(log_lvl_str(level));
-            case FORMAT_TOKEN_TIMESTAMP:
-                ms_since_boot = to_ms_since_boot(get_absolute_time());
-                timestamp_sec = ms_since_boot / 1000;
-                timestamp_millisec = ms_since_boot - (timestamp_sec * 1000);
-                BUFF_SPRINTF("%lu.%03u", timestamp_sec, timestamp_millisec);
-            case FORMAT_TOKEN_CORE:
-                if (get_core_num()) {
-                    BUFFER_CONCAT("core1");
-                } else {
-                    BUFFER_CONCAT("core0");
-                }
-            case FORMAT_TOKEN_MSG:
-                BUFFER_CONCAT(msg);
+        const log_format_token_t& token = this->log_format_tokens[ansi_styling][i];
+
+        switch (token.type) {
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_TEXT);
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_FUNC);
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_FILE);
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_LINE);
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_TASK);
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_LEVEL);
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_TIMESTAMP);
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_CORE);
+            FORMAT_TOKEN_CASE(FORMAT_TOKEN_MSG);
             case FORMAT_TOKEN_END:
-                goto exit_loop;
+                break;
+        }
+
+        break;
+    }
+
+    this->msg_format_end(out);
+    #endif
+}
+
+// Updates the cached seconds part of the timestamp. Returns the milliseconds part.
+// The seconds are only recomputed (and re-rendered) when they change.
+inline uint32_t Logger::timestamp_update(const uint32_t timestamp_ms) {
+    uint32_t timestamp_millisec = timestamp_ms - this->timestamp.sec_start_ms;
+
+    if (timestamp_ms < this->timestamp.sec_start_ms || timestamp_millisec >= 1000) {
+        // Usually the next second, which doesn't require a division.
+        if (timestamp_ms >= this->timestamp.sec_start_ms && timestamp_millisec < 2000) {
+            this->timestamp.sec++;
+            this->timestamp.sec_start_ms += 1000;
+        } else {
+            this->timestamp.sec = timestamp_ms / 1000;
+            this->timestamp.sec_start_ms = this->timestamp.sec * 1000;
         }
+
+        this->timestamp.sec_str_len = uint_to_str(this->timestamp.sec, this->timestamp.sec_str, 1);
+        timestamp_millisec = timestamp_ms - this->timestamp.sec_start_ms;
+    }
+
+    return timestamp_millisec;
+}
+
+// Terminates a formatted message with CRLF.
+// If the buffer is full, the last character is replaced.
+inline void Logger::msg_format_end(log_output_t& out) {
+    if (out.buff_pos < out.buff_size - 1) {
+        output_const(out, "\r\n", 2);
+        return;
     }
 
-    exit_loop:
-    if (buff_pos < buff_size - 1) {
-        buff[buff_pos]     = '\r';
-        buff[buff_pos + 1] = '\n';
-        return buff_pos + 2;
+    size_t buff_start = out.buff_pos;
+
+    // The last character belongs to a constant segment, cut it off instead
+    if (out.segments != nullptr && out.buff_pos >= 1 && !output_in_buff(out)) {
+        out.segments[out.num_segments - 1].len--;
+        buff_start--;
     }
 
-    if (buff_pos >= 1) {
-        buff[buff_pos - 1] = '\r';
-        buff[buff_pos]     = '\n';
+    if (out.buff_pos >= 1) {
+        out.buff[out.buff_pos - 1] = '\r';
+        out.buff[out.buff_pos]     = '\n';
     }
 
-    return buff_pos + 1;
+    out.buff_pos++;
+    output_commit(out, buff_start);
 }
 
-#define PROCESS_COLOR_SPEC(color, ptr_skip)                   \
-    clr_spec = process_color_spec(color, src_ptr, ptr_skip);  \
-    if (clr_spec.success) {                                   \
-        BUFF_SPRINTF("\033[0;%dm", ansi_color_code(clr_spec)) \
+// Formats a message (and its arguments) directly into the output buffer.
+inline void Logger::msg_write(log_output_t& out, const log_message_t& msg, const bool ansi_styling) {
+    char* msg_buff = out.buff + out.buff_pos;
+    const size_t msg_buff_size = out.buff_size - out.buff_pos;
+    const size_t buff_start = out.buff_pos;
+    const char* format = (!ansi_styling && msg.plain_format != nullptr) ? msg.plain_format : msg.format;
+    const STYLE_TAG_MODE style_tags = !msg.proc_style_tags ? STYLE_TAGS_KEEP : ansi_styling ? STYLE_TAGS_TRANSLATE : STYLE_TAGS_REMOVE;
+    va_list args;
+    int msg_len = 0;
+
+    // Already formatted (and constant until the message is output)
+    if (msg.type == MESSAGE_TEXT) {
+        output_concat(out, format);
+        return;
     }
 
-inline void Logger::msg_process_style(const char* src_ptr, char* buff, const size_t buff_size) {
-    color_spec_t clr_spec;
-    size_t buff_pos_size_n, str_len, buff_pos = 0;
-    
-    while (*src_ptr && buff_pos < buff_size) {
-        if (*src_ptr == '%') {
-            src_ptr++;
-
-            switch (*src_ptr) {
-                case 'I':
-                    if (memcmp(src_ptr, "ITL%", 4) == 0) {
-                        src_ptr += 4;
-                        BUFFER_CONCAT(ANSI_ITALIC);
-                    }
-                    break;
-                case 'U':
-                    if (memcmp(src_ptr, "UDRLN%", 6) == 0) {
-                        src_ptr += 6;
-                        BUFFER_CONCAT(ANSI_UNDERLINE);
-                    }
-                    break;
-                case 'S':
-                    if (memcmp(src_ptr, "STKTHR%", 7) == 0) {
-                        src_ptr += 7;
-                        BUFFER_CONCAT(ANSI_STRIKETHROUGH);
-                    }
-                    break;
-                case 'B':
-                    if (memcmp(src_ptr, "BOLD%", 5) == 0) {
-                        src_ptr += 5;
-                        BUFFER_CONCAT(ANSI_BOLD);
-                    } else if (memcmp(src_ptr, "BLU", 3) == 0) {
-                        PROCESS_COLOR_SPEC(COLOR_BLUE, 3);
-                    } else if (memcmp(src_ptr, "BLK", 3) == 0) {
-                        PROCESS_COLOR_SPEC(COLOR_BLACK, 3);
-                    }
-                    break;
-                case 'R':
-                    if (memcmp(src_ptr, "RED", 3) == 0) {
-                        PROCESS_COLOR_SPEC(COLOR_RED, 3);
-                    } else if (memcmp(src_ptr, "RST%", 4) == 0) {
-                        src_ptr += 4;
-                        BUFFER_CONCAT(ANSI_RESET);
-                    }
-                    break;
-                case 'G':
-                    if (memcmp(src_ptr, "GRN", 3) == 0) {
-                        PROCESS_COLOR_SPEC(COLOR_GREEN, 3);
-                    }
-                    break;
-                case 'Y':
-                    if (memcmp(src_ptr, "YLW", 3) == 0) {
-                        PROCESS_COLOR_SPEC(COLOR_YELLOW, 3);
-                    }
-                    break;
-                case 'M':
-                    if (memcmp(src_ptr, "MGT", 3) == 0) {
-                        PROCESS_COLOR_SPEC(COLOR_MAGENTA, 3);
-                    }
-                    break;
-                case 'C':
-                    if (memcmp(src_ptr, "CYN", 3) == 0) {
-                        PROCESS_COLOR_SPEC(COLOR_CYAN, 3);
-                    }
-                    break;
-                case 'W':
-                    if (memcmp(src_ptr, "WHT", 3) == 0) {
-                        PROCESS_COLOR_SPEC(COLOR_WHITE, 3);
-                    }
-                    break;
+    if (out.buff_pos + 1 >= out.buff_size) {
+        return;
+    }
+
+    switch (msg.type) {
+        case MESSAGE_TEXT:
+            break;
+        case MESSAGE_VA_LIST:
+            // Copied, in case the log format contains more than one %MSG% token.
+            va_copy(args, *msg.va_args);
+            if (style_tags != STYLE_TAGS_KEEP) {
+                msg_len = log_vsnprintf_styled(msg_buff, msg_buff_size, format, args, style_tags);
+            } else {
+                msg_len = vsnprintf(msg_buff, msg_buff_size, format, args);
+
+                // Keep whatever was written if vsnprintf() failed on an invalid conversion.
+                if (msg_len < 0) {
+                    msg_len = strnlen(msg_buff, msg_buff_size - 1);
+                }
             }
+            va_end(args);
+            break;
+        case MESSAGE_CAPTURED:
+            msg_len = log_args_vsnprintf(msg_buff, msg_buff_size, format, msg.captured_args, msg.captured_args_len, style_tags);
+            break;
+        case MESSAGE_TYPED:
+            msg_len = log_typed_format(msg_buff, msg_buff_size, format, msg.typed_args, msg.num_typed_args, style_tags);
+            break;
+    }
 
-            buff[buff_pos++] = '%';
-            continue;
-        }
-            
-        buff[buff_pos++] = *src_ptr++;
+    if (msg_len > 0) {
+        out.buff_pos += ((size_t) msg_len < msg_buff_size) ? msg_len : msg_buff_size - 1;
     }
 
-    buff[buff_pos] = '\0';
+    output_commit(out, buff_start);
 }
\ No newline at end of file
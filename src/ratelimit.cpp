@@ -0,0 +1,44 @@
+/*
+    Pico Log - Log rate limiting.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "pico_log_lib/ratelimit.h"
+#include "pico/time.h"
+#include <cassert>
+
+
+bool log_rate_limit_take(log_rate_limit_t* limit, const uint32_t rate, const uint32_t burst) {
+    assert(limit != nullptr);
+    const uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+
+    // rate tokens per second is rate thousandths of a token per millisecond.
+    const uint64_t refill = (uint64_t) (now_ms - limit->last_ms) * rate;
+    limit->last_ms = now_ms;
+    limit->used = (refill >= limit->used) ? 0 : limit->used - (uint32_t) refill;
+
+    if ((uint64_t) limit->used + 1000 > (uint64_t) burst * 1000) {
+        return false;
+    }
+
+    limit->used += 1000;
+    return true;
+}
\ No newline at end of file
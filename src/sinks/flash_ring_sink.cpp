@@ -0,0 +1,288 @@
+/*
+    Pico Log - Flash ring sink.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "pico_log_lib/sinks/flash_ring_sink.h"
+#include "pico/flash.h"
+#include <cassert>
+#include <cstring>
+
+
+static_assert(sizeof(flash_ring_page_t) == FLASH_PAGE_SIZE, "Flash ring pages must be exactly FLASH_PAGE_SIZE bytes");
+static_assert((FLASH_RING_SINK_PAGES & (FLASH_RING_SINK_PAGES - 1)) == 0, "FLASH_RING_SINK_PAGES must be a power of two");
+
+constexpr uint32_t FLASH_RING_PAGES_PER_SECTOR = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE;
+
+// Page programming parameters, passed to flash_safe_execute().
+struct flash_ring_program {
+    uint32_t flash_offset;
+    bool erase;
+    const flash_ring_page_t* page;
+};
+
+
+// Returns a region page, read through the XIP window.
+static const flash_ring_page_t* flash_ring_sink_page(const flash_ring_sink_t* sink, const uint32_t page_idx) {
+    return reinterpret_cast<const flash_ring_page_t*>(XIP_BASE + sink->flash_offset + page_idx * FLASH_PAGE_SIZE);
+}
+
+// FNV-1a checksum of a page's sequence number, length and log bytes.
+static uint32_t flash_ring_sink_checksum(const flash_ring_page_t* page) {
+    const uint32_t fields[] = {page->header.seq, page->header.len};
+    uint32_t checksum = 2166136261u;
+
+    for (size_t i = 0; i < sizeof(fields); i++) {
+        checksum = (checksum ^ reinterpret_cast<const uint8_t*>(fields)[i]) * 16777619u;
+    }
+
+    for (size_t i = 0; i < page->header.len; i++) {
+        checksum = (checksum ^ (uint8_t) page->data[i]) * 16777619u;
+    }
+
+    return checksum;
+}
+
+// Returns true if a page in flash holds log bytes.
+static bool flash_ring_sink_page_valid(const flash_ring_page_t* page) {
+    return page->header.magic == FLASH_RING_SINK_MAGIC && page->header.len <= FLASH_RING_SINK_PAGE_DATA && 
+           page->header.checksum == flash_ring_sink_checksum(page);
+}
+
+// Returns true if a page in flash is erased (can be programmed).
+static bool flash_ring_sink_page_erased(const flash_ring_page_t* page) {
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(page);
+
+    for (size_t i = 0; i < FLASH_PAGE_SIZE / sizeof(uint32_t); i++) {
+        if (words[i] != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Erases the page's sector (if it is the first page of the sector) and programs the page.
+// Called by flash_safe_execute(), with the other core and interrupts locked out.
+static void flash_ring_sink_program_page(void* param) {
+    const flash_ring_program* program = static_cast<const flash_ring_program*>(param);
+
+    if (program->erase) {
+        flash_range_erase(program->flash_offset, FLASH_SECTOR_SIZE);
+    }
+
+    flash_range_program(program->flash_offset, reinterpret_cast<const uint8_t*>(program->page), FLASH_PAGE_SIZE);
+}
+
+// Returns true if len bytes fit into the free page buffers. Otherwise, counts them as dropped.
+static bool flash_ring_sink_reserve(flash_ring_sink_t* sink, const size_t len) {
+    const uint32_t irq_state = spin_lock_blocking(sink->lock);
+    const uint32_t used = sink->head - sink->tail;
+    spin_unlock(sink->lock, irq_state);
+
+    // The page being filled is one of the free pages.
+    const size_t free = (used < FLASH_RING_SINK_PAGES) ? (FLASH_RING_SINK_PAGES - used) * FLASH_RING_SINK_PAGE_DATA - sink->fill_len : 0;
+
+    if (len > free) {
+        sink->dropped = sink->dropped + len;
+        return false;
+    }
+
+    return true;
+}
+
+// Hands the page being filled over to flash_ring_sink_service().
+static void flash_ring_sink_seal(flash_ring_sink_t* sink) {
+    sink->pages[sink->head % FLASH_RING_SINK_PAGES].header.len = sink->fill_len;
+    sink->fill_len = 0;
+
+    const uint32_t irq_state = spin_lock_blocking(sink->lock);
+    sink->head = sink->head + 1;
+    spin_unlock(sink->lock, irq_state);
+}
+
+// Copies reserved bytes into the page buffers, sealing each page once it is full.
+static void flash_ring_sink_append(flash_ring_sink_t* sink, const char* buf, size_t len) {
+    while (len > 0) {
+        flash_ring_page_t* page = &sink->pages[sink->head % FLASH_RING_SINK_PAGES];
+        const size_t copy_len = (len < FLASH_RING_SINK_PAGE_DATA - sink->fill_len) ? len : FLASH_RING_SINK_PAGE_DATA - sink->fill_len;
+
+        memcpy(page->data + sink->fill_len, buf, copy_len);
+        sink->fill_len += copy_len;
+        buf += copy_len;
+        len -= copy_len;
+
+        if (sink->fill_len == FLASH_RING_SINK_PAGE_DATA) {
+            flash_ring_sink_seal(sink);
+        }
+    }
+}
+
+// Log sink output function (contiguous message).
+static void flash_ring_sink_out_chars(void* ctx, const char* buf, size_t len) {
+    flash_ring_sink_t* sink = static_cast<flash_ring_sink_t*>(ctx);
+
+    if (flash_ring_sink_reserve(sink, len)) {
+        flash_ring_sink_append(sink, buf, len);
+    }
+}
+
+// Log sink output function (segmented message).
+static void flash_ring_sink_out_segments(void* ctx, const log_segment_t* segments, size_t num_segments) {
+    flash_ring_sink_t* sink = static_cast<flash_ring_sink_t*>(ctx);
+    size_t len = 0;
+
+    for (size_t i = 0; i < num_segments; i++) {
+        len += segments[i].len;
+    }
+
+    if (!flash_ring_sink_reserve(sink, len)) {
+        return;
+    }
+
+    for (size_t i = 0; i < num_segments; i++) {
+        flash_ring_sink_append(sink, segments[i].data, segments[i].len);
+    }
+}
+
+
+bool flash_ring_sink_init(flash_ring_sink_t* sink, uint32_t flash_offset, uint32_t size) {
+    assert(sink != nullptr);
+
+    if (size == 0 || flash_offset % FLASH_SECTOR_SIZE != 0 || size % FLASH_SECTOR_SIZE != 0) {
+        return false;
+    }
+
+    sink->flash_offset = flash_offset;
+    sink->num_pages = size / FLASH_PAGE_SIZE;
+    sink->write_page = 0;
+    sink->next_seq = 0;
+    sink->head = 0;
+    sink->tail = 0;
+    sink->fill_len = 0;
+    sink->dropped = 0;
+    sink->lock = spin_lock_instance(spin_lock_claim_unused(true));
+
+    // Recovery scan: continue after the newest valid page.
+    bool found = false;
+
+    for (uint32_t i = 0; i < sink->num_pages; i++) {
+        const flash_ring_page_t* page = flash_ring_sink_page(sink, i);
+
+        if (flash_ring_sink_page_valid(page) && (!found || (int32_t) (page->header.seq - sink->next_seq) >= 0)) {
+            found = true;
+            sink->write_page = (i + 1) % sink->num_pages;
+            sink->next_seq = page->header.seq + 1;
+        }
+    }
+
+    // A page left partially programmed by a power loss can't be programmed again, continue in the next sector.
+    if (sink->write_page % FLASH_RING_PAGES_PER_SECTOR != 0 && !flash_ring_sink_page_erased(flash_ring_sink_page(sink, sink->write_page))) {
+        sink->write_page = ((sink->write_page / FLASH_RING_PAGES_PER_SECTOR + 1) * FLASH_RING_PAGES_PER_SECTOR) % sink->num_pages;
+    }
+
+    return true;
+}
+
+log_sink_t flash_ring_sink_get(flash_ring_sink_t* sink) {
+    assert(sink != nullptr);
+    return {sink, flash_ring_sink_out_chars, flash_ring_sink_out_segments};
+}
+
+size_t flash_ring_sink_service(flash_ring_sink_t* sink) {
+    assert(sink != nullptr);
+    size_t num_pages = 0;
+
+    while (true) {
+        const uint32_t irq_state = spin_lock_blocking(sink->lock);
+        const bool pending = sink->tail != sink->head;
+        spin_unlock(sink->lock, irq_state);
+
+        if (!pending) {
+            break;
+        }
+
+        // Full pages are only accessed here until they are released.
+        flash_ring_page_t* page = &sink->pages[sink->tail % FLASH_RING_SINK_PAGES];
+        memset(page->data + page->header.len, 0xFF, FLASH_RING_SINK_PAGE_DATA - page->header.len);
+        page->header.magic = FLASH_RING_SINK_MAGIC;
+        page->header.seq = sink->next_seq;
+        page->header.checksum = flash_ring_sink_checksum(page);
+
+        flash_ring_program program = {sink->flash_offset + sink->write_page * FLASH_PAGE_SIZE, 
+                                      sink->write_page % FLASH_RING_PAGES_PER_SECTOR == 0, page};
+
+        if (flash_safe_execute(flash_ring_sink_program_page, &program, FLASH_RING_SINK_SAFE_TIMEOUT_MS) != PICO_OK) {
+            break;
+        }
+
+        sink->write_page = (sink->write_page + 1) % sink->num_pages;
+        sink->next_seq++;
+        num_pages++;
+
+        const uint32_t release_state = spin_lock_blocking(sink->lock);
+        sink->tail = sink->tail + 1;
+        spin_unlock(sink->lock, release_state);
+    }
+
+    return num_pages;
+}
+
+void flash_ring_sink_flush(flash_ring_sink_t* sink) {
+    assert(sink != nullptr);
+
+    if (sink->fill_len > 0) {
+        flash_ring_sink_seal(sink);
+    }
+
+    flash_ring_sink_service(sink);
+}
+
+size_t flash_ring_sink_read(const flash_ring_sink_t* sink, size_t offset, char* buff, size_t size) {
+    assert(sink != nullptr && buff != nullptr);
+    size_t len = 0;
+
+    // The oldest page is the next one to be programmed (or the first valid one after it).
+    for (uint32_t i = 0; i < sink->num_pages && len < size; i++) {
+        const flash_ring_page_t* page = flash_ring_sink_page(sink, (sink->write_page + i) % sink->num_pages);
+
+        if (!flash_ring_sink_page_valid(page)) {
+            continue;
+        }
+
+        if (offset >= page->header.len) {
+            offset -= page->header.len;
+            continue;
+        }
+
+        const size_t copy_len = (page->header.len - offset < size - len) ? page->header.len - offset : size - len;
+        memcpy(buff + len, page->data + offset, copy_len);
+        len += copy_len;
+        offset = 0;
+    }
+
+    return len;
+}
+
+uint32_t flash_ring_sink_get_dropped(const flash_ring_sink_t* sink) {
+    assert(sink != nullptr);
+    return sink->dropped;
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+    Pico Log - Crash-persistent RAM ring sink.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "pico_log_lib/sinks/ram_ring_sink.h"
+#include <cassert>
+#include <cstring>
+
+
+static_assert((RAM_RING_SINK_BUFF_SIZE & (RAM_RING_SINK_BUFF_SIZE - 1)) == 0, "RAM_RING_SINK_BUFF_SIZE must be a power of two");
+
+
+// Returns the header checksum for the given head position and pending length.
+static uint32_t ram_ring_sink_checksum(const uint32_t head, const uint32_t pending) {
+    return ((head ^ RAM_RING_SINK_BUFF_SIZE) * 2654435761u) ^ (pending * 2246822519u) ^ RAM_RING_SINK_MAGIC;
+}
+
+// Records the message length as pending, copies the message into the ring, then moves the head past it and clears pending.
+// The barriers keep the copy between the two header updates, so a reset during the copy always leaves pending set.
+// Only the last RAM_RING_SINK_BUFF_SIZE bytes of longer messages are kept.
+static void ram_ring_sink_append(ram_ring_sink_t* sink, const char* buf, size_t len) {
+    if (len > RAM_RING_SINK_BUFF_SIZE) {
+        buf += len - RAM_RING_SINK_BUFF_SIZE;
+        len = RAM_RING_SINK_BUFF_SIZE;
+    }
+
+    const uint32_t head = sink->head;
+    const uint32_t offset = head & (RAM_RING_SINK_BUFF_SIZE - 1);
+    const size_t first_len = (len < RAM_RING_SINK_BUFF_SIZE - offset) ? len : RAM_RING_SINK_BUFF_SIZE - offset;
+
+    sink->pending = len;
+    sink->checksum = ram_ring_sink_checksum(head, len);
+    __dmb();
+
+    memcpy(sink->buff + offset, buf, first_len);
+    memcpy(sink->buff, buf + first_len, len - first_len);
+
+    __dmb();
+    sink->head = head + len;
+    sink->pending = 0;
+    sink->checksum = ram_ring_sink_checksum(head + len, 0);
+}
+
+// Log sink output function (contiguous message).
+static void ram_ring_sink_out_chars(void* ctx, const char* buf, size_t len) {
+    ram_ring_sink_append(static_cast<ram_ring_sink_t*>(ctx), buf, len);
+}
+
+// Log sink output function (segmented message).
+static void ram_ring_sink_out_segments(void* ctx, const log_segment_t* segments, size_t num_segments) {
+    for (size_t i = 0; i < num_segments; i++) {
+        ram_ring_sink_append(static_cast<ram_ring_sink_t*>(ctx), segments[i].data, segments[i].len);
+    }
+}
+
+
+RAM_RING_SINK_STATE_t ram_ring_sink_check(const ram_ring_sink_t* sink) {
+    assert(sink != nullptr);
+
+    if (sink->magic != RAM_RING_SINK_MAGIC || sink->size != RAM_RING_SINK_BUFF_SIZE) {
+        return RAM_RING_SINK_EMPTY;
+    }
+
+    // A checksum mismatch means the reset happened during a header update, a pending length during a copy.
+    if (sink->checksum != ram_ring_sink_checksum(sink->head, sink->pending) || sink->pending != 0) {
+        return RAM_RING_SINK_CORRUPT;
+    }
+
+    return (sink->head > 0) ? RAM_RING_SINK_VALID : RAM_RING_SINK_EMPTY;
+}
+
+size_t ram_ring_sink_len(const ram_ring_sink_t* sink) {
+    assert(sink != nullptr);
+
+    // Bytes overwritten by an interrupted message are left out: it starts at the head, and may have wrapped onto the oldest ones.
+    const uint32_t pending = (sink->pending < RAM_RING_SINK_BUFF_SIZE) ? sink->pending : RAM_RING_SINK_BUFF_SIZE;
+    const uint32_t size = RAM_RING_SINK_BUFF_SIZE - pending;
+    return (sink->head < size) ? sink->head : size;
+}
+
+size_t ram_ring_sink_read(const ram_ring_sink_t* sink, size_t offset, char* buff, size_t size) {
+    assert(sink != nullptr && buff != nullptr);
+    const size_t len = ram_ring_sink_len(sink);
+
+    if (offset >= len) {
+        return 0;
+    }
+
+    if (size > len - offset) {
+        size = len - offset;
+    }
+
+    // The oldest byte is at the head position once the ring has wrapped around, at 0 before.
+    const uint32_t start = sink->head - len + offset;
+
+    for (size_t i = 0; i < size; i++) {
+        buff[i] = sink->buff[(start + i) & (RAM_RING_SINK_BUFF_SIZE - 1)];
+    }
+
+    return size;
+}
+
+void ram_ring_sink_init(ram_ring_sink_t* sink) {
+    assert(sink != nullptr);
+    sink->magic = RAM_RING_SINK_MAGIC;
+    sink->size = RAM_RING_SINK_BUFF_SIZE;
+    sink->head = 0;
+    sink->pending = 0;
+    sink->checksum = ram_ring_sink_checksum(0, 0);
+}
+
+log_sink_t ram_ring_sink_get(ram_ring_sink_t* sink) {
+    assert(sink != nullptr);
+    return {sink, ram_ring_sink_out_chars, ram_ring_sink_out_segments};
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+/*
+    Pico Log - DMA-driven UART sink.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "pico_log_lib/sinks/uart_dma_sink.h"
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include <cassert>
+#include <cstring>
+
+static_assert((UART_DMA_SINK_BUFF_SIZE & (UART_DMA_SINK_BUFF_SIZE - 1)) == 0, "UART_DMA_SINK_BUFF_SIZE must be a power of two");
+
+
+// Sinks by DMA channel, for the shared interrupt handler.
+static uart_dma_sink_t* uart_dma_sinks[NUM_DMA_CHANNELS] = {};
+static uint32_t uart_dma_sink_count = 0;
+
+// Starts a DMA transfer of all queued bytes. The sink lock must be held.
+static void uart_dma_sink_start(uart_dma_sink_t* sink) {
+    const uint32_t len = sink->head - sink->tail;
+    
+    if (sink->transfer_len != 0 || len == 0) {
+        return;
+    }
+
+    // The read address wraps around the buffer (DMA read ring), so a single transfer is enough.
+    sink->transfer_len = len;
+    dma_channel_set_read_addr(sink->dma_channel, sink->buff + (sink->tail & (UART_DMA_SINK_BUFF_SIZE - 1)), false);
+    dma_channel_set_trans_count(sink->dma_channel, len, true);
+}
+
+// Shared DMA interrupt handler, frees the sent bytes and sends the ones queued in the meantime.
+static void uart_dma_sink_irq_handler() {
+    for (uint32_t channel = 0; channel < NUM_DMA_CHANNELS; channel++) {
+        uart_dma_sink_t* sink = uart_dma_sinks[channel];
+
+        if (sink == nullptr || !dma_irqn_get_channel_status(UART_DMA_SINK_DMA_IRQ, channel)) {
+            continue;
+        }
+
+        dma_irqn_acknowledge_channel(UART_DMA_SINK_DMA_IRQ, channel);
+
+        const uint32_t irq_state = spin_lock_blocking(sink->lock);
+        sink->tail = sink->tail + sink->transfer_len;
+        sink->transfer_len = 0;
+        uart_dma_sink_start(sink);
+        spin_unlock(sink->lock, irq_state);
+    }
+}
+
+// Waits for len bytes of free space. Returns false (and counts the message as dropped)
+// if the message doesn't fit and the sink doesn't block, or if it can never fit.
+static bool uart_dma_sink_reserve(uart_dma_sink_t* sink, const size_t len) {
+    if (len > UART_DMA_SINK_BUFF_SIZE) {
+        sink->dropped = sink->dropped + 1;
+        return false;
+    }
+
+    // Only the interrupt handler moves the tail, which only frees space.
+    while (UART_DMA_SINK_BUFF_SIZE - (sink->head - sink->tail) < len) {
+        if (sink->full_policy != UART_DMA_SINK_BLOCK) {
+            sink->dropped = sink->dropped + 1;
+            return false;
+        }
+
+        tight_loop_contents();
+    }
+
+    return true;
+}
+
+// Copies data into the ring buffer at pos (a running byte count), wrapping around its end.
+static void uart_dma_sink_copy(uart_dma_sink_t* sink, const uint32_t pos, const char* data, const size_t len) {
+    const uint32_t buff_pos = pos & (UART_DMA_SINK_BUFF_SIZE - 1);
+    const size_t first_len = (len < UART_DMA_SINK_BUFF_SIZE - buff_pos) ? len : UART_DMA_SINK_BUFF_SIZE - buff_pos;
+
+    memcpy(sink->buff + buff_pos, data, first_len);
+    memcpy(sink->buff, data + first_len, len - first_len);
+}
+
+// Queues the copied bytes and starts a transfer if the DMA is idle.
+static void uart_dma_sink_commit(uart_dma_sink_t* sink, const uint32_t head) {
+    const uint32_t irq_state = spin_lock_blocking(sink->lock);
+    sink->head = head;
+    uart_dma_sink_start(sink);
+    spin_unlock(sink->lock, irq_state);
+}
+
+// Log sink output function (contiguous message).
+static void uart_dma_sink_out_chars(void* ctx, const char* buf, size_t len) {
+    uart_dma_sink_t* sink = static_cast<uart_dma_sink_t*>(ctx);
+
+    if (!uart_dma_sink_reserve(sink, len)) {
+        return;
+    }
+
+    uart_dma_sink_copy(sink, sink->head, buf, len);
+    uart_dma_sink_commit(sink, sink->head + len);
+}
+
+// Log sink output function (list of segments), copies the segments straight into the ring buffer.
+static void uart_dma_sink_out_segments(void* ctx, const log_segment_t* segments, size_t num_segments) {
+    uart_dma_sink_t* sink = static_cast<uart_dma_sink_t*>(ctx);
+    size_t len = 0;
+
+    for (size_t i = 0; i < num_segments; i++) {
+        len += segments[i].len;
+    }
+
+    if (!uart_dma_sink_reserve(sink, len)) {
+        return;
+    }
+
+    uint32_t head = sink->head;
+
+    for (size_t i = 0; i < num_segments; i++) {
+        uart_dma_sink_copy(sink, head, segments[i].data, segments[i].len);
+        head += segments[i].len;
+    }
+
+    uart_dma_sink_commit(sink, head);
+}
+
+
+bool uart_dma_sink_init(uart_dma_sink_t* sink, uart_inst_t* uart, UART_DMA_SINK_FULL_POLICY_t full_policy) {
+    assert(sink != nullptr && uart != nullptr);
+
+    sink->dma_channel = dma_claim_unused_channel(false);
+    if (sink->dma_channel < 0) {
+        return false;
+    }
+
+    sink->uart = uart;
+    sink->lock = spin_lock_instance(spin_lock_claim_unused(true));
+    sink->head = 0;
+    sink->tail = 0;
+    sink->transfer_len = 0;
+    sink->dropped = 0;
+    sink->full_policy = full_policy;
+
+    dma_channel_config config = dma_channel_get_default_config(sink->dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_ring(&config, false, __builtin_ctz(UART_DMA_SINK_BUFF_SIZE));
+    channel_config_set_dreq(&config, uart_get_dreq(uart, true));
+    dma_channel_configure(sink->dma_channel, &config, &uart_get_hw(uart)->dr, sink->buff, 0, false);
+
+    uart_dma_sinks[sink->dma_channel] = sink;
+    dma_irqn_set_channel_enabled(UART_DMA_SINK_DMA_IRQ, sink->dma_channel, true);
+
+    if (uart_dma_sink_count++ == 0) {
+        irq_add_shared_handler(DMA_IRQ_0 + UART_DMA_SINK_DMA_IRQ, uart_dma_sink_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0 + UART_DMA_SINK_DMA_IRQ, true);
+    }
+
+    return true;
+}
+
+void uart_dma_sink_deinit(uart_dma_sink_t* sink) {
+    assert(sink != nullptr);
+
+    uart_dma_sink_flush(sink);
+    dma_irqn_set_channel_enabled(UART_DMA_SINK_DMA_IRQ, sink->dma_channel, false);
+    uart_dma_sinks[sink->dma_channel] = nullptr;
+
+    if (--uart_dma_sink_count == 0) {
+        irq_remove_handler(DMA_IRQ_0 + UART_DMA_SINK_DMA_IRQ, uart_dma_sink_irq_handler);
+    }
+
+    dma_channel_unclaim(sink->dma_channel);
+    spin_lock_unclaim(spin_lock_get_num(sink->lock));
+    sink->dma_channel = -1;
+}
+
+log_sink_t uart_dma_sink_get(uart_dma_sink_t* sink) {
+    assert(sink != nullptr);
+    return {sink, uart_dma_sink_out_chars, uart_dma_sink_out_segments};
+}
+
+void uart_dma_sink_flush(uart_dma_sink_t* sink) {
+    assert(sink != nullptr);
+
+    while (sink->tail != sink->head) {
+        tight_loop_contents();
+    }
+
+    uart_tx_wait_blocking(sink->uart);
+}
+
+uint32_t uart_dma_sink_get_dropped(const uart_dma_sink_t* sink) {
+    assert(sink != nullptr);
+    return sink->dropped;
+}
\ No newline at end of file
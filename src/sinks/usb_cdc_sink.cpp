@@ -0,0 +1,167 @@
+/*
+    Pico Log - Non-blocking USB CDC sink.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "pico_log_lib/sinks/usb_cdc_sink.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+#include <cassert>
+
+
+/*
+    TinyUSB's FIFOs and endpoints are not locked (without an RTOS), and pico_stdio_usb runs
+    tud_task() from an interrupt. Every access is made with interrupts disabled, so that
+    tud_task() can't run in the middle of it on this core. Interrupts are enabled again
+    between the accesses, so the FIFO can be emptied while the sink waits for space.
+*/
+
+// Returns the free space in the transmit FIFO.
+static uint32_t usb_cdc_sink_available(usb_cdc_sink_t* sink) {
+    const uint32_t irq_state = save_and_disable_interrupts();
+    const uint32_t available = tud_cdc_n_write_available(sink->itf);
+    restore_interrupts(irq_state);
+    return available;
+}
+
+// Sends the queued bytes (including a partial packet) to the host.
+static void usb_cdc_sink_write_flush(usb_cdc_sink_t* sink) {
+    const uint32_t irq_state = save_and_disable_interrupts();
+    tud_cdc_n_write_flush(sink->itf);
+    restore_interrupts(irq_state);
+}
+
+// Waits (for at most timeout_us) until len bytes fit into the transmit FIFO.
+// Returns false (and counts the bytes as dropped) if they don't, or if the port is not open.
+static bool usb_cdc_sink_reserve(usb_cdc_sink_t* sink, const size_t len) {
+    if (tud_cdc_n_connected(sink->itf)) {
+        if (usb_cdc_sink_available(sink) >= len) {
+            return true;
+        }
+
+        if (sink->timeout_us > 0) {
+            // Send the partial packet too, the FIFO is only emptied by the host
+            usb_cdc_sink_write_flush(sink);
+            const absolute_time_t timeout = make_timeout_time_us(sink->timeout_us);
+
+            while (!time_reached(timeout)) {
+                if (usb_cdc_sink_available(sink) >= len) {
+                    return true;
+                }
+
+                tight_loop_contents();
+            }
+        }
+    }
+
+    sink->dropped = sink->dropped + len;
+    return false;
+}
+
+// Flushes the transmit FIFO according to the flush mode, after a message has been written.
+// TinyUSB sends whole packets by itself, as soon as they are filled.
+static void usb_cdc_sink_end(usb_cdc_sink_t* sink) {
+    if (sink->flush_mode == USB_CDC_SINK_FLUSH_MESSAGE) {
+        usb_cdc_sink_write_flush(sink);
+        return;
+    }
+
+    if (!sink->pending) {
+        sink->pending = true;
+        sink->pending_since = time_us_32();
+        return;
+    }
+
+    usb_cdc_sink_poll(sink);
+}
+
+// Log sink output function (contiguous message).
+static void usb_cdc_sink_out_chars(void* ctx, const char* buf, size_t len) {
+    usb_cdc_sink_t* sink = static_cast<usb_cdc_sink_t*>(ctx);
+
+    if (!usb_cdc_sink_reserve(sink, len)) {
+        return;
+    }
+
+    const uint32_t irq_state = save_and_disable_interrupts();
+    tud_cdc_n_write(sink->itf, buf, len);
+    restore_interrupts(irq_state);
+    usb_cdc_sink_end(sink);
+}
+
+// Log sink output function (list of segments), writes the segments straight into the transmit FIFO.
+static void usb_cdc_sink_out_segments(void* ctx, const log_segment_t* segments, size_t num_segments) {
+    usb_cdc_sink_t* sink = static_cast<usb_cdc_sink_t*>(ctx);
+    size_t len = 0;
+
+    for (size_t i = 0; i < num_segments; i++) {
+        len += segments[i].len;
+    }
+
+    if (!usb_cdc_sink_reserve(sink, len)) {
+        return;
+    }
+
+    const uint32_t irq_state = save_and_disable_interrupts();
+
+    for (size_t i = 0; i < num_segments; i++) {
+        tud_cdc_n_write(sink->itf, segments[i].data, segments[i].len);
+    }
+
+    restore_interrupts(irq_state);
+    usb_cdc_sink_end(sink);
+}
+
+
+void usb_cdc_sink_init(usb_cdc_sink_t* sink, uint8_t itf, USB_CDC_SINK_FLUSH_t flush_mode, uint32_t timeout_us) {
+    assert(sink != nullptr);
+
+    sink->itf = itf;
+    sink->flush_mode = flush_mode;
+    sink->timeout_us = timeout_us;
+    sink->pending_since = 0;
+    sink->pending = false;
+    sink->dropped = 0;
+}
+
+log_sink_t usb_cdc_sink_get(usb_cdc_sink_t* sink) {
+    assert(sink != nullptr);
+    return {sink, usb_cdc_sink_out_chars, usb_cdc_sink_out_segments};
+}
+
+void usb_cdc_sink_poll(usb_cdc_sink_t* sink) {
+    assert(sink != nullptr);
+
+    if (sink->pending && time_us_32() - sink->pending_since >= USB_CDC_SINK_FLUSH_INTERVAL_US) {
+        usb_cdc_sink_flush(sink);
+    }
+}
+
+void usb_cdc_sink_flush(usb_cdc_sink_t* sink) {
+    assert(sink != nullptr);
+
+    usb_cdc_sink_write_flush(sink);
+    sink->pending = false;
+}
+
+uint32_t usb_cdc_sink_get_dropped(const usb_cdc_sink_t* sink) {
+    assert(sink != nullptr);
+    return sink->dropped;
+}
\ No newline at end of file
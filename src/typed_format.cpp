@@ -0,0 +1,238 @@
+/*
+    Pico Log - Type-safe message formatter.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "pico_log_lib/internal/typed_format.h"
+#include "pico_log_lib/internal/buff_write.h"
+#include <cmath>
+
+
+// Powers of ten that fit in 32 bits.
+constexpr uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+// Maximum number of decimal places of floating and fixed-point values.
+constexpr uint8_t MAX_DECIMALS = 9;
+
+
+// Appends a signed or unsigned 64-bit integer to buff.
+static inline void buff_write_int64(char* buff, const size_t buff_size, size_t& buff_pos, const uint64_t value, const bool negative) {
+    char str[21];
+    size_t str_len = 0;
+
+    if (negative) {
+        str[str_len++] = '-';
+    }
+
+    str_len += uint64_to_str(value, str + str_len);
+    buff_append(buff, buff_size, buff_pos, str, str_len);
+}
+
+// Appends "<whole>.<frac>" to buff, frac is zero-padded to the given number of decimal places.
+static inline void buff_write_decimal(char* buff, const size_t buff_size, size_t& buff_pos, const uint64_t whole, 
+                                      const uint32_t frac, const uint8_t decimals, const bool negative) {
+    char str[10];
+    buff_write_int64(buff, buff_size, buff_pos, whole, negative);
+
+    if (decimals > 0) {
+        buff_append(buff, buff_size, buff_pos, ".", 1);
+        buff_append(buff, buff_size, buff_pos, str, uint_to_str(frac, str, decimals));
+    }
+}
+
+// Appends a float or double, rounded to the given number of decimal places like printf("%.*f") (ties to even).
+// Float arguments are promoted to double first, so that all of their digits are exact. Values with an integer part
+// that does not fit in 64 bits are written in exponent notation instead ("1.000e+20").
+static void buff_write_float(char* buff, const size_t buff_size, size_t& buff_pos, double value, uint8_t decimals) {
+    if (value != value) {
+        buff_concat(buff, buff_size, buff_pos, "nan");
+        return;
+    }
+
+    const bool negative = std::signbit(value);
+    value = negative ? -value : value;
+    decimals = (decimals > MAX_DECIMALS) ? MAX_DECIMALS : decimals;
+
+    if (std::isinf(value)) {
+        buff_concat(buff, buff_size, buff_pos, negative ? "-inf" : "inf");
+        return;
+    }
+
+    // Normalized to [1, 10)
+    const bool exp_notation = value >= 18446744073709551616.0;
+    uint32_t exponent = 0;
+
+    while (exp_notation && value >= 1e16) {
+        value /= 1e16;
+        exponent += 16;
+    }
+
+    while (exp_notation && value >= 10) {
+        value /= 10;
+        exponent++;
+    }
+
+    // The integer part and the fraction are exact. Scaling the fraction can round, and the
+    // rounding error decides the ties: 0.0005 is stored as 0.000500000000000000010..., which rounds up.
+    uint64_t whole = (uint64_t) value;
+    const double frac_value = value - (double) whole;
+    const double frac_scaled = frac_value * POW10[decimals];
+    const double frac_error = std::fma(frac_value, (double) POW10[decimals], -frac_scaled);
+    uint32_t frac = (uint32_t) frac_scaled;
+    const double remainder = frac_scaled - frac;
+
+    if (remainder > 0.5 || (remainder == 0.5 && (frac_error > 0 || (frac_error == 0 && (((decimals > 0) ? frac : whole) & 1))))) {
+        if (++frac >= POW10[decimals]) {
+            frac = 0;
+            whole++;
+        }
+    }
+
+    if (exp_notation && whole >= 10) {
+        whole = 1;
+        exponent++;
+    }
+
+    buff_write_decimal(buff, buff_size, buff_pos, whole, frac, decimals, negative);
+
+    if (exp_notation) {
+        char str[10];
+        buff_append(buff, buff_size, buff_pos, "e+", 2);
+        buff_append(buff, buff_size, buff_pos, str, uint_to_str(exponent, str, 2));
+    }
+}
+
+// Appends a signed fixed-point value (raw / 2^frac_bits), rounded to the given number of decimal places.
+static inline void buff_write_fixed(char* buff, const size_t buff_size, size_t& buff_pos, const int32_t raw, 
+                                    uint8_t frac_bits, uint8_t decimals) {
+    const bool negative = raw < 0;
+    const uint32_t raw_abs = negative ? -(uint32_t) raw : raw;
+
+    frac_bits = (frac_bits > 31) ? 31 : frac_bits;
+    decimals = (decimals > MAX_DECIMALS) ? MAX_DECIMALS : decimals;
+
+    uint64_t whole = raw_abs >> frac_bits;
+    const uint64_t frac_raw = raw_abs & ((1u << frac_bits) - 1);
+    uint32_t frac = (frac_raw * POW10[decimals] + ((1u << frac_bits) >> 1)) >> frac_bits;
+
+    // Rounded up to the next whole number
+    if (frac >= POW10[decimals]) {
+        frac -= POW10[decimals];
+        whole++;
+    }
+
+    buff_write_decimal(buff, buff_size, buff_pos, whole, frac, decimals, negative);
+}
+
+// Appends a single argument to buff.
+static void buff_write_arg(char* buff, const size_t buff_size, size_t& buff_pos, const log_typed_arg_t& arg) {
+    char str[18];
+
+    switch (arg.type) {
+        case TYPED_ARG_BOOL:
+            buff_concat(buff, buff_size, buff_pos, arg.u32 ? "true" : "false");
+            break;
+        case TYPED_ARG_CHAR:
+            str[0] = arg.u32;
+            buff_append(buff, buff_size, buff_pos, str, 1);
+            break;
+        case TYPED_ARG_INT:
+            buff_write_int64(buff, buff_size, buff_pos, (arg.i32 < 0) ? -(uint32_t) arg.i32 : arg.i32, arg.i32 < 0);
+            break;
+        case TYPED_ARG_UINT:
+            buff_write_uint(buff, buff_size, buff_pos, arg.u32, 1);
+            break;
+        case TYPED_ARG_INT64:
+            buff_write_int64(buff, buff_size, buff_pos, (arg.i64 < 0) ? -(uint64_t) arg.i64 : arg.i64, arg.i64 < 0);
+            break;
+        case TYPED_ARG_UINT64:
+            buff_write_int64(buff, buff_size, buff_pos, arg.u64, false);
+            break;
+        case TYPED_ARG_HEX:
+            buff_append(buff, buff_size, buff_pos, str, uint_to_hex(arg.u64, str, arg.digits));
+            break;
+        case TYPED_ARG_FLOAT:
+            buff_write_float(buff, buff_size, buff_pos, (double) arg.f32, arg.digits);
+            break;
+        case TYPED_ARG_DOUBLE:
+            buff_write_float(buff, buff_size, buff_pos, arg.f64, arg.digits);
+            break;
+        case TYPED_ARG_FIXED:
+            buff_write_fixed(buff, buff_size, buff_pos, arg.i32, arg.frac_bits, arg.digits);
+            break;
+        case TYPED_ARG_STR:
+            buff_concat(buff, buff_size, buff_pos, (arg.str != nullptr) ? arg.str : "(null)");
+            break;
+        case TYPED_ARG_PTR:
+            str[0] = '0';
+            str[1] = 'x';
+            buff_append(buff, buff_size, buff_pos, str, 2 + uint_to_hex((uintptr_t) arg.ptr, str + 2, sizeof(void*) * 2));
+            break;
+        default:
+            break;
+    }
+}
+
+
+size_t log_typed_format(char* buff, const size_t buff_size, const char* format, 
+                        const log_typed_arg_t* args, const size_t num_args, const STYLE_TAG_MODE style_tags) {
+    size_t buff_pos = 0, arg_idx = 0;
+
+    if (buff_size == 0) {
+        return 0;
+    }
+
+    while (*format && buff_pos < buff_size - 1) {
+        const char chr = *format;
+
+        // Escaped characters ("{{", "}}", "%%")
+        if ((chr == '{' || chr == '}' || chr == '%') && format[1] == chr) {
+            buff[buff_pos++] = chr;
+            format += 2;
+            continue;
+        }
+
+        if (chr == '{' && format[1] == '}' && arg_idx < num_args) {
+            buff_write_arg(buff, buff_size, buff_pos, args[arg_idx++]);
+            format += 2;
+            continue;
+        }
+
+        if (chr == '%' && style_tags != STYLE_TAGS_KEEP) {
+            const style_tag_t tag = style_tag_parse(format);
+
+            if (tag.len > 0) {
+                if (style_tags == STYLE_TAGS_TRANSLATE && tag.style != nullptr) {
+                    buff_concat(buff, buff_size, buff_pos, tag.style);
+                } else if (style_tags == STYLE_TAGS_TRANSLATE) {
+                    buff_write_color(buff, buff_size, buff_pos, tag.color_code);
+                }
+
+                format += tag.len;
+                continue;
+            }
+        }
+
+        buff[buff_pos++] = chr;
+        format++;
+    }
+
+    buff[buff_pos] = '\0';
+    return buff_pos;
+}
\ No newline at end of file
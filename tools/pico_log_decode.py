@@ -0,0 +1,476 @@
+#!/usr/bin/env python3
+"""
+    Pico Log - Tokenized log decoder.
+    A fast logging library for RP2xxx microcontrollers.
+
+    Copyright 2025 Samyar Sadat Akhavi.
+    Written by Samyar Sadat Akhavi, 2025.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+"""
+
+"""
+    Decodes the output of a logger built with PICO_LOG_TOKENIZED.
+    The messages and call sites of the tokens are read from the pico_log_tokens
+    table of the firmware ELF file (see include/pico_log_lib/internal/tokens.h).
+
+    Usage: pico_log_decode.py firmware.elf [-i capture.bin | -p /dev/ttyACM0] [--color] [--format FORMAT]
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+
+# Token ID of text frames (messages formatted on the device).
+LOG_TOKEN_TEXT = 0
+
+# Marker length of null string arguments.
+ARG_STR_NULL = 0xFF
+
+# Device log levels.
+LOG_LEVELS = ["DEBUG", "INFO", "WARNING", "ERROR", "FATAL"]
+LOG_LEVEL_COLORS = [36, 34, 33, 31, 35]
+
+# Style tags and their ANSI escape codes, color tags in ANSI color code order.
+STYLE_TAG_STYLES = {"BOLD": "\033[1m", "ITL": "\033[3m", "UDRLN": "\033[4m", "STKTHR": "\033[9m", "RST": "\033[0m"}
+STYLE_TAG_COLORS = ["BLK", "RED", "GRN", "YLW", "BLU", "MGT", "CYN", "WHT"]
+
+DEFAULT_FORMAT = "[%TSTMP%] [%LVL%] [%FUNC%:%LINE%]: %MSG%"
+
+ELF_SECTION = "pico_log_tokens"
+ELF_SHF_ALLOC = 0x2
+ELF_SHT_NOBITS = 8
+ELF_EM_X86_64 = 62
+
+
+class ElfFile:
+    """Minimal ELF reader: section contents and null-terminated strings at run-time addresses."""
+
+    def __init__(self, path):
+        with open(path, "rb") as elf:
+            self.data = elf.read()
+
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+
+        self.is_64 = self.data[4] == 2
+        self.endian = "<" if self.data[5] == 1 else ">"
+        self.ptr_size = 8 if self.is_64 else 4
+
+        if self.is_64:
+            machine, = struct.unpack_from(self.endian + "H", self.data, 18)
+            sh_off, = struct.unpack_from(self.endian + "Q", self.data, 40)
+            sh_entsize, sh_num, sh_strndx = struct.unpack_from(self.endian + "HHH", self.data, 58)
+            sh_format = "IIQQQQIIQQ"
+        else:
+            machine, = struct.unpack_from(self.endian + "H", self.data, 18)
+            sh_off, = struct.unpack_from(self.endian + "I", self.data, 32)
+            sh_entsize, sh_num, sh_strndx = struct.unpack_from(self.endian + "HHH", self.data, 46)
+            sh_format = "IIIIIIIIII"
+
+        self.machine = machine
+        self.sections = []
+
+        for i in range(sh_num):
+            name, sh_type, flags, addr, offset, size = struct.unpack_from(self.endian + sh_format, self.data, sh_off + i * sh_entsize)[:6]
+            self.sections.append({"name": name, "type": sh_type, "flags": flags, "addr": addr, "offset": offset, "size": size})
+
+        names_offset = self.sections[sh_strndx]["offset"]
+        for section in self.sections:
+            section["name"] = self.read_cstr(names_offset + section["name"])
+
+    def read_cstr(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("utf-8", errors="replace")
+
+    def section(self, name):
+        for section in self.sections:
+            if section["name"] == name:
+                return section
+        return None
+
+    def offset_at(self, addr):
+        """Returns the file offset of a run-time address, or None if it isn't stored in the file."""
+        for section in self.sections:
+            if (section["flags"] & ELF_SHF_ALLOC and section["type"] != ELF_SHT_NOBITS and 
+                section["addr"] <= addr < section["addr"] + section["size"]):
+                return section["offset"] + addr - section["addr"]
+        return None
+
+    def read_cstr_at(self, addr):
+        """Returns the null-terminated string at a run-time address, or None if it isn't stored in the file."""
+        offset = self.offset_at(addr)
+        return None if offset is None else self.read_cstr(offset)
+
+
+def load_tokens(elf):
+    """Reads the token descriptors (log_token_t) of an ELF file, indexed by token ID."""
+    section = elf.section(ELF_SECTION)
+    if section is None:
+        raise ValueError(f"no {ELF_SECTION} section (was the firmware built with PICO_LOG_TOKENIZED?)")
+
+    # The section is a table of descriptor addresses. A descriptor can be listed more than once
+    # (call sites in inline functions and templates).
+    # uint32_t id; const char* format, * func, * file; uint16_t line; uint8_t level;
+    ptr = "Q" if elf.is_64 else "I"
+    table_entry = struct.Struct(elf.endian + ptr)
+    entry = struct.Struct(elf.endian + "I" + ("4x" if elf.is_64 else "") + ptr * 3 + "HB")
+    tokens = {}
+
+    for table_offset in range(0, section["size"] - table_entry.size + 1, table_entry.size):
+        token_addr, = table_entry.unpack_from(elf.data, section["offset"] + table_offset)
+        offset = elf.offset_at(token_addr)
+        if offset is None:
+            continue
+
+        token_id, format_ptr, func_ptr, file_ptr, line, level = entry.unpack_from(elf.data, offset)
+        token = {"format": elf.read_cstr_at(format_ptr) or "", "func": elf.read_cstr_at(func_ptr) or "?", 
+                 "file": elf.read_cstr_at(file_ptr) or "?", "line": line, "level": level}
+
+        if token_id in tokens and tokens[token_id]["format"] != token["format"]:
+            print(f"warning: token ID collision ({token_id:08x}): {token['file']}:{line} and "
+                  f"{tokens[token_id]['file']}:{tokens[token_id]['line']}", file=sys.stderr)
+
+        tokens[token_id] = token
+
+    return tokens
+
+
+def style_tag_parse(text, pos):
+    """Parses the style tag at text[pos] ('%'). Returns (length, ANSI escape code), or (0, None)."""
+    for name, ansi in STYLE_TAG_STYLES.items():
+        if text.startswith(name + "%", pos + 1):
+            return len(name) + 2, ansi
+
+    for color_idx, name in enumerate(STYLE_TAG_COLORS):
+        if not text.startswith(name, pos + 1):
+            continue
+
+        color_code = 30 + color_idx
+        tag_len = len(name) + 1
+        bright = background = False
+
+        # Color suffixes (_HI, _BG), each can be used once.
+        while text.startswith("_", pos + tag_len):
+            if not bright and text.startswith("HI", pos + tag_len + 1):
+                color_code += 60
+                bright = True
+            elif not background and text.startswith("BG", pos + tag_len + 1):
+                color_code += 10
+                background = True
+            else:
+                break
+
+            tag_len += 3
+
+        if text.startswith("%", pos + tag_len):
+            return tag_len + 1, f"\033[0;{color_code}m"
+        return 0, None
+
+    return 0, None
+
+
+def style_translate(text, styled):
+    """Replaces the style tags of a string with their ANSI escape codes, or removes them."""
+    out, pos = [], 0
+
+    while pos < len(text):
+        if text[pos] != "%" or text.startswith("%%", pos):
+            out.append(text[pos:pos + 2] if text.startswith("%%", pos) else text[pos])
+            pos += 2 if text.startswith("%%", pos) else 1
+            continue
+
+        tag_len, ansi = style_tag_parse(text, pos)
+        if tag_len == 0:
+            out.append("%")
+            pos += 1
+            continue
+
+        out.append(ansi if styled else "")
+        pos += tag_len
+
+    return "".join(out)
+
+
+# printf conversion specification (same grammar as parse_format_spec() in src/arg_capture.cpp).
+FORMAT_SPEC = re.compile(r"%(?P<flags>[-+ #0']*)(?P<width>\*|\d*)(?:\.(?P<precision>\*|\d*))?"
+                         r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conv>.?)", re.DOTALL)
+
+# Maximum length of a conversion specification formatted on the device.
+FORMAT_SPEC_MAX_LEN = 16
+
+
+class ArgReader:
+    """Reads arguments captured by log_args_capture(), with the sizes of the target."""
+
+    def __init__(self, data, elf):
+        self.data, self.pos, self.elf = data, 0, elf
+        long_size = 8 if elf.is_64 else 4
+        self.sizes = {"int": 4, "long": long_size, "llong": 8, "intmax": 8, "size": elf.ptr_size, "ptrdiff": elf.ptr_size, 
+                      "double": 8, "ldouble": 16 if elf.is_64 else 8, "ptr": elf.ptr_size}
+
+    def read_int(self, arg_type, signed):
+        size = self.sizes[arg_type]
+        if self.pos + size > len(self.data):
+            raise IndexError
+        value = int.from_bytes(self.data[self.pos:self.pos + size], "little" if self.elf.endian == "<" else "big", signed=signed)
+        self.pos += size
+        return value
+
+    def read_float(self, arg_type):
+        size = self.sizes[arg_type]
+        if self.pos + size > len(self.data):
+            raise IndexError
+        raw = self.data[self.pos:self.pos + size]
+        self.pos += size
+
+        if size == 8:
+            return struct.unpack(self.elf.endian + "d", raw)[0]
+
+        # 16-byte long double: x87 80-bit extended precision, or IEEE quad precision.
+        bits = int.from_bytes(raw, "little" if self.elf.endian == "<" else "big")
+        if self.elf.machine == ELF_EM_X86_64:
+            mantissa, exponent, sign = bits & ((1 << 64) - 1), (bits >> 64) & 0x7FFF, (bits >> 79) & 1
+            value = float("inf") if exponent == 0x7FFF else mantissa * 2.0 ** (exponent - 16383 - 63)
+        else:
+            mantissa, exponent, sign = bits & ((1 << 112) - 1), (bits >> 112) & 0x7FFF, (bits >> 127) & 1
+            value = float("inf") if exponent == 0x7FFF else (mantissa / 2.0 ** 112 + (exponent != 0)) * 2.0 ** (max(exponent, 1) - 16383)
+        return -value if sign else value
+
+    def read_str(self):
+        if self.pos + 1 > len(self.data):
+            raise IndexError
+        str_len = self.data[self.pos]
+        if str_len == ARG_STR_NULL:
+            self.pos += 1
+            return "(null)"
+        if self.pos + 1 + str_len > len(self.data):
+            raise IndexError
+        value = self.data[self.pos + 1:self.pos + 1 + str_len].decode("utf-8", errors="replace")
+        self.pos += 1 + str_len
+        return value
+
+
+def format_spec(spec, reader):
+    """Formats a single conversion specification with the next captured arguments (like the device's printf)."""
+    flags = spec["flags"].replace("'", "")
+    width, precision = spec["width"], spec["precision"]
+    length, conv = spec["length"] or "", spec["conv"]
+
+    if width == "*":
+        width = reader.read_int("int", True)
+        if width < 0:
+            flags, width = flags + "-", -width
+        width = str(width)
+    if precision == "*":
+        precision = reader.read_int("int", True)
+        precision = None if precision < 0 else str(precision)
+
+    py_spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+    int_type = {"l": "long", "ll": "llong", "j": "intmax", "z": "size", "t": "ptrdiff"}.get(length, "int")
+
+    if conv in "di":
+        return (py_spec + "d") % reader.read_int(int_type, True)
+    if conv in "uoxX":
+        value = reader.read_int(int_type, False)
+        if length == "hh":
+            value &= 0xFF
+        elif length == "h":
+            value &= 0xFFFF
+        if conv == "o" and "#" in flags:
+            return (py_spec.replace("#", "") + "s") % ("0" + "%o" % value if value else "0")
+        return (py_spec + ("d" if conv == "u" else conv)) % value
+    if conv == "c":
+        return ("%" + flags + (width or "") + "c") % chr(reader.read_int("int", True) & 0xFF)
+    if conv in "fFeEgG":
+        return (py_spec + conv) % reader.read_float("ldouble" if length == "L" else "double")
+    if conv in "aA":
+        value = reader.read_float("ldouble" if length == "L" else "double").hex()
+        return ("%" + flags.replace("#", "").replace("0", "") + (width or "") + "s") % (value.upper() if conv == "A" else value)
+    if conv == "s" and length == "l":
+        return ("%" + flags + (width or "") + "s") % hex(reader.read_int("ptr", False))
+    if conv == "s":
+        return (py_spec + "s") % reader.read_str()
+    if conv == "p":
+        return ("%" + flags.replace("0", "") + (width or "") + "s") % hex(reader.read_int("ptr", False))
+    return ""
+
+
+def format_message(message, args, elf, styled):
+    """Formats a token message with its captured arguments. Style tags are translated, or removed."""
+    reader = ArgReader(args, elf)
+    out, pos = [], 0
+
+    while pos < len(message):
+        if message[pos] != "%" or message.startswith("%%", pos):
+            out.append(message[pos])
+            pos += 2 if message.startswith("%%", pos) else 1
+            continue
+
+        tag_len, ansi = style_tag_parse(message, pos)
+        if tag_len > 0:
+            out.append(ansi if styled else "")
+            pos += tag_len
+            continue
+
+        spec = FORMAT_SPEC.match(message, pos)
+        spec_len = spec.end() - pos
+
+        # Unknown or oversized specifications are printed as literal text.
+        if spec["conv"] not in "diouxXcfFeEgGaAspn" or spec["conv"] == "" or spec_len > FORMAT_SPEC_MAX_LEN:
+            out.append(message[pos:spec.end()])
+            pos = spec.end()
+            continue
+
+        # Formatting stops at the first argument that was not captured.
+        try:
+            out.append(format_spec(spec, reader))
+        except IndexError:
+            break
+
+        pos = spec.end()
+
+    return "".join(out)
+
+
+class TokenDecoder:
+    """Splits a byte stream into frames, and turns them into log lines."""
+
+    def __init__(self, elf, tokens, log_format, styled):
+        self.elf, self.tokens, self.styled = elf, tokens, styled
+        self.log_format = style_translate(log_format, styled)
+        self.frame = bytearray()
+        self.last_ms = None
+
+    def feed(self, data):
+        """Decodes the complete frames in data (and in the previous unterminated data). Yields log lines."""
+        for byte in data:
+            if byte != 0:
+                self.frame.append(byte)
+                continue
+
+            frame = cobs_decode(self.frame)
+            self.frame.clear()
+
+            if frame is not None and len(frame) >= 4:
+                yield self.decode_frame(frame)
+
+    def decode_frame(self, frame):
+        token_id, = struct.unpack_from("<I", frame)
+
+        if token_id == LOG_TOKEN_TEXT:
+            return frame[4:].decode("utf-8", errors="replace").rstrip("\r\n")
+
+        timestamp, pos = varint_decode(frame, 4)
+        if timestamp & 1:
+            self.last_ms = timestamp >> 1
+        elif self.last_ms is not None:
+            delta = timestamp >> 1
+            self.last_ms = (self.last_ms + ((delta >> 1) ^ -(delta & 1))) & 0xFFFFFFFF
+
+        token = self.tokens.get(token_id)
+        if token is None:
+            return f"<unknown token {token_id:08x}: {frame[pos:].hex()}>"
+
+        level = token["level"]
+        level_str = LOG_LEVELS[level] if level < len(LOG_LEVELS) else "UNKNOWN"
+        if self.styled:
+            level_str = f"\033[0;{LOG_LEVEL_COLORS[level] if level < len(LOG_LEVELS) else 37}m{level_str}\033[0m"
+
+        fields = {
+            "TSTMP": "?.???" if self.last_ms is None else f"{self.last_ms // 1000}.{self.last_ms % 1000:03d}",
+            "LVL": level_str,
+            "FUNC": token["func"],
+            "FILE": token["file"],
+            "LINE": str(token["line"]),
+            "TASK": "?",
+            "CORE": "?",
+            "MSG": format_message(token["format"], frame[pos:], self.elf, self.styled),
+        }
+
+        return re.sub(r"%(TSTMP|LVL|FUNC|FILE|LINE|TASK|CORE|MSG)%", lambda field: fields[field[1]], self.log_format)
+
+
+def cobs_decode(data):
+    """Decodes a COBS-encoded frame (without its zero byte). Returns None if it is malformed."""
+    out, pos = bytearray(), 0
+
+    while pos < len(data):
+        code = data[pos]
+        if code == 0 or pos + code > len(data):
+            return None
+
+        out += data[pos + 1:pos + code]
+        pos += code
+
+        if code != 0xFF and pos < len(data):
+            out.append(0)
+
+    return bytes(out)
+
+
+def varint_decode(data, pos):
+    """Decodes the varint at data[pos]. Returns its value and the position after it."""
+    value, shift = 0, 0
+
+    while pos < len(data):
+        byte = data[pos]
+        value |= (byte & 0x7F) << shift
+        pos += 1
+        shift += 7
+
+        if not byte & 0x80:
+            break
+
+    return value, pos
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodes the output of a Pico Log logger built with PICO_LOG_TOKENIZED.")
+    parser.add_argument("elf", help="firmware ELF file (with the pico_log_tokens section)")
+    parser.add_argument("-i", "--input", help="captured log stream (default: stdin)")
+    parser.add_argument("-p", "--port", help="serial port to read the log stream from (requires pyserial)")
+    parser.add_argument("-b", "--baud", type=int, default=115200, help="serial port baud rate (default: 115200)")
+    parser.add_argument("-f", "--format", default=DEFAULT_FORMAT, help=f"log format of tokenized messages (default: \"{DEFAULT_FORMAT.replace('%', '%%')}\")")
+    parser.add_argument("-c", "--color", action="store_true", help="translate style tags into ANSI escape codes (removed otherwise)")
+    args = parser.parse_args()
+
+    elf = ElfFile(args.elf)
+    decoder = TokenDecoder(elf, load_tokens(elf), args.format, args.color)
+
+    if args.port:
+        import serial
+        stream = serial.Serial(args.port, args.baud, timeout=0.1)
+    else:
+        stream = open(args.input, "rb") if args.input else sys.stdin.buffer
+
+    # read1() returns what is available, instead of waiting for the whole block.
+    read = getattr(stream, "read1", stream.read)
+
+    try:
+        while True:
+            data = read(4096)
+            if not data and not args.port:
+                break
+
+            for line in decoder.feed(data):
+                print(line, flush=True)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
\ No newline at end of file